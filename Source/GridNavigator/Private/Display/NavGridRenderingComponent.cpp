@@ -77,18 +77,23 @@ FDebugRenderSceneProxy* UNavGridRenderingComponent::CreateDebugSceneProxy()
 		return nullptr;
 	}
 
-	const auto NodeList = NavGrid->GetNodeList();
+	// the snapshot stays pinned while its nodes are streamed straight into the proxy
+	const TSharedPtr<const FNavGridLevel> Level = NavGrid->GetLevelData();
+	if (!Level) {
+		return NavGridSceneProxy;
+	}
+	NavGridSceneProxy->Boxes.Reserve(Level->Map.GetNumNodes());
 	
-	for (const auto& Node : NodeList) {
+	for (const NavGrid::FNodeView Node : Level->Map.GetNodes()) {
 		const FVector BoxPos(Node.Index.X * 100.00, Node.Index.Y * 100.0, Node.Index.Z * 25.0);
 		const FVector BoxDiagonal(2.5, 2.5, 2.5);
 
 		const FBox BoxDims(BoxPos - BoxDiagonal, BoxPos + BoxDiagonal);
 		FColor BoxColor(0, 255, 0);
 		
-		for (const auto& [InNodeID, OutNodeID, EdgeType, EdgeDirection] : Node.OutEdges) {
+		for (const NavGrid::FPackedEdge Edge : Node.OutEdges) {
 			FColor LineColor;
-			switch(EdgeType) {
+			switch(Edge.GetType()) {
 			case NavGrid::EMapEdgeType::None:
 				LineColor = FColor(50, 50, 50);
 				break;
@@ -110,7 +115,8 @@ FDebugRenderSceneProxy* UNavGridRenderingComponent::CreateDebugSceneProxy()
 			const FIntVector3 InNodeIndex(Node.Index.X, Node.Index.Y, Node.Index.Z);
 			const FVector InNodeWorldPos = GridNavigatorConfig::GridIndexToWorld(InNodeIndex);
 
-			const FIntVector3 OutNodeIndex(Node.Index.X + EdgeDirection.X, Node.Index.Y + EdgeDirection.Y, Node.Index.Z + EdgeDirection.Z);
+			const NavGrid::FAdjacencyListIndex OutIndex = Edge.GetTarget(Node.Index);
+			const FIntVector3 OutNodeIndex(OutIndex.X, OutIndex.Y, OutIndex.Z);
 			const FVector OutNodeWorldPos = GridNavigatorConfig::GridIndexToWorld(OutNodeIndex);
 
 			// slight offset so arrows don't all start and end in the same place; increases readability
@@ -105,18 +105,9 @@ bool UGNCursorComponent::UpdatePosition(const FVector& WorldDestination, const F
 		UE_LOG(LogGNCursorComponent, Error, TEXT("Failed to retrieve OwnerActor when trying to UpdatePosition"));
 		return false;
 	}
-	const FVector& OwnerActorLocation = OwnerActor->GetActorLocation();
-	const FVector FloorTraceEnd(OwnerActorLocation.X, OwnerActorLocation.Y, OwnerActorLocation.Z - 1000.0);
-
-	// trace from character position to floor to get pathfinding start location
-	FHitResult FloorTraceResult;
-	const bool bFloorBelowCharacterFound = World->LineTraceSingleByObjectType(FloorTraceResult, OwnerActorLocation, FloorTraceEnd, ECC_WorldStatic);
-	if (!bFloorBelowCharacterFound) {
-		UE_LOG(LogGNCursorComponent, Warning, TEXT("Tried to UpdatePosition while character was not above a valid floor"));
-		return false;
-	}
-	
-	UNavigationPath* FoundPath = NavSys->FindPathToLocationSynchronously(OwnerActor, FloorTraceResult.Location, DestinationRounded);
+
+	// the navigation data snaps the start of the path from the character down to the nearest grid node
+	UNavigationPath* FoundPath = NavSys->FindPathToLocationSynchronously(OwnerActor, OwnerActor->GetActorLocation(), DestinationRounded);
 	if (FoundPath == nullptr || !FoundPath->IsValid()) {
 		return false;
 	}
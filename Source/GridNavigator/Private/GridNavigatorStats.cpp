@@ -0,0 +1,10 @@
+#include "GridNavigatorStats.h"
+
+DEFINE_STAT(STAT_GridNavigator_ArenaPeakNodes);
+DEFINE_STAT(STAT_GridNavigator_ArenaPeakMemory);
+DEFINE_STAT(STAT_GridNavigator_LandmarkMemory);
+DEFINE_STAT(STAT_GridNavigator_FrozenGraphMemory);
+DEFINE_STAT(STAT_GridNavigator_NodesExpanded);
+DEFINE_STAT(STAT_GridNavigator_PathCacheHits);
+DEFINE_STAT(STAT_GridNavigator_PathCacheMisses);
+DEFINE_STAT(STAT_GridNavigator_PathCacheEvictions);
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("GridNavigator"), STATGROUP_GridNavigator, STATCAT_Advanced);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Search Arena Peak Nodes"), STAT_GridNavigator_ArenaPeakNodes, STATGROUP_GridNavigator, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Search Arena Peak Memory"), STAT_GridNavigator_ArenaPeakMemory, STATGROUP_GridNavigator, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Landmark Tables Memory"), STAT_GridNavigator_LandmarkMemory, STATGROUP_GridNavigator, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Frozen Graph Memory"), STAT_GridNavigator_FrozenGraphMemory, STATGROUP_GridNavigator, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nodes Expanded"), STAT_GridNavigator_NodesExpanded, STATGROUP_GridNavigator, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Path Cache Hits"), STAT_GridNavigator_PathCacheHits, STATGROUP_GridNavigator, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Path Cache Misses"), STAT_GridNavigator_PathCacheMisses, STATGROUP_GridNavigator, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Path Cache Evictions"), STAT_GridNavigator_PathCacheEvictions, STATGROUP_GridNavigator, );
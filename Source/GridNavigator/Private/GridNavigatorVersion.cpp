@@ -0,0 +1,7 @@
+#include "GridNavigatorVersion.h"
+
+#include "Serialization/CustomVersion.h"
+
+const FGuid FGridNavigatorVersion::GUID(0xE2D8EC79, 0xF0DB4403, 0xA97510F3, 0xFFF77869);
+
+FCustomVersionRegistration GRegisterGridNavigatorVersion(FGridNavigatorVersion::GUID, FGridNavigatorVersion::LatestVersion, TEXT("GridNavigatorVer"));
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Misc/Guid.h"
+
+/**
+ * @brief Versions of the navigation data that ANavigationGridData saves, so that data saved by an older version of
+ * the plugin can still be loaded. Add new versions at the end, right before VersionPlusOne.
+ */
+struct FGridNavigatorVersion
+{
+	enum Type
+	{
+		// saved before the custom version was registered
+		BeforeCustomVersionWasAdded = 0,
+
+		// unpacked edges store the height of the floor halfway along them
+		EdgeMidpointHeights,
+
+		// the adjacency list stores its nodes tile by tile, with their edges packed into 32 bits
+		PackedEdges,
+
+		// the level stores its landmark tables after the adjacency list
+		LandmarkTables,
+
+		// -----<new versions can be added above this line>-------------------------------------------------
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	static const FGuid GUID;
+
+private:
+	FGridNavigatorVersion() {}
+};
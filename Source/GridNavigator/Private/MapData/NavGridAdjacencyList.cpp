@@ -4,113 +4,473 @@
 #include <optional>
 
 #include "GridNavigatorConfig.h"
+#include "GridNavigatorVersion.h"
+#include "Async/ParallelFor.h"
 #include "Navigation/AStarNavigator.h"
 
 DECLARE_LOG_CATEGORY_CLASS(LogNavGridAdjacencyList, Log, All)
 
 using NavGrid::FAdjacencyListIndex;
 
-std::optional<std::reference_wrapper<const NavGrid::FNode>> FNavGridAdjacencyList::GetNode(const int64 X, const int64 Y, const int64 Z) const
+namespace
 {
-	const FAdjacencyListIndex Index(X, Y, Z);
-	if (!Nodes.Contains(Index)) {
-		return std::nullopt;
-	}
-	return Nodes[Index];
+	// a node as navigation data saved before edges were packed stored it: its index, then its unpacked edges
+	struct FUnpackedNode
+	{
+		FAdjacencyListIndex Index = FAdjacencyListIndex(0);
+		TArray<NavGrid::FEdge> OutEdges;
+
+		friend FArchive& operator<<(FArchive& Ar, FUnpackedNode& Rhs)
+		{
+			Ar << Rhs.Index.X << Rhs.Index.Y << Rhs.Index.Z << Rhs.OutEdges;
+			return Ar;
+		}
+	};
 }
 
-std::optional<std::reference_wrapper<const NavGrid::FNode>> FNavGridAdjacencyList::GetNode(const FAdjacencyListIndex& Index) const
+std::optional<NavGrid::FNodeView> FNavGridAdjacencyList::GetNode(const int64 X, const int64 Y, const int64 Z) const
 {
-	if (!Nodes.Contains(Index)) {
+	return GetNode(FAdjacencyListIndex(X, Y, Z));
+}
+
+std::optional<NavGrid::FNodeView> FNavGridAdjacencyList::GetNode(const FAdjacencyListIndex& Index) const
+{
+	int32 Slot;
+	const FTile* Tile = FindTile(Index, Slot);
+	if (!Tile) {
 		return std::nullopt;
 	}
-	return Nodes[Index];
+	return Tile->GetNodeView(Slot);
 }
 
-bool FNavGridAdjacencyList::HasNode(const int X, const int Y, const int Z) const
+void FNavGridAdjacencyList::AddNode(const int64 X, const int64 Y, const int64 Z)
 {
-	const FAdjacencyListIndex Index(X, Y, Z);
-	return Nodes.Contains(Index);
+	AddNode(FAdjacencyListIndex(X, Y, Z));
 }
 
-bool FNavGridAdjacencyList::HasNode(const FAdjacencyListIndex& Index) const
+void FNavGridAdjacencyList::AddNode(const FAdjacencyListIndex& Index)
 {
-	return Nodes.Contains(Index);
+	if (HasNode(Index)) {
+		return;
+	}
+
+	FTile& Tile = Tiles[FindOrAddTile(Index.X, Index.Y)];
+	checkf(Tile.Nodes.Num() < MaxNodesPerTile, TEXT("Too many nodes in the tile holding (%lld, %lld, %lld)"), Index.X, Index.Y, Index.Z);
+
+	const int32 Column = GetColumn(Index.X, Index.Y);
+	const int32 Slot = Tile.Nodes.AddDefaulted();
+	FTileNode& Node = Tile.Nodes[Slot];
+	Node.Z = static_cast<int32>(Index.Z);
+	Node.Column = static_cast<uint8>(Column);
+	Node.FirstEdge = Tile.Edges.Num();
+	Node.FirstInNeighbor = Tile.InNeighbors.Num();
+	Node.NextInColumn = Tile.ColumnHeads[Column];
+	Tile.ColumnHeads[Column] = static_cast<int16>(Slot);
+
+	++NumNodes;
 }
 
-void FNavGridAdjacencyList::AddNode(const int64 X, const int64 Y, const int64 Z)
+int32 FNavGridAdjacencyList::FindOrAddTile(const int64 X, const int64 Y)
 {
-	const FAdjacencyListIndex Index(X, Y, Z);
-	Nodes.Emplace(Index, NavGrid::FNode(Index));
+	const int64 TileX = X >> TileShift;
+	const int64 TileY = Y >> TileShift;
+
+	// the directory only ever grows, and it is rare for a node to land outside of it once a build is underway
+	const bool bIsInDirectory = TileX >= DirectoryMinX && TileY >= DirectoryMinY && TileX < DirectoryMinX + DirectorySizeX && TileY < DirectoryMinY + DirectorySizeY;
+	if (!bIsInDirectory) {
+		const int64 NewMinX = TileDirectory.IsEmpty() ? TileX : FMath::Min(TileX, DirectoryMinX);
+		const int64 NewMinY = TileDirectory.IsEmpty() ? TileY : FMath::Min(TileY, DirectoryMinY);
+		const int64 NewSizeX = (TileDirectory.IsEmpty() ? TileX : FMath::Max(TileX, DirectoryMinX + DirectorySizeX - 1)) - NewMinX + 1;
+		const int64 NewSizeY = (TileDirectory.IsEmpty() ? TileY : FMath::Max(TileY, DirectoryMinY + DirectorySizeY - 1)) - NewMinY + 1;
+		checkf(NewSizeX * NewSizeY <= MAX_int32, TEXT("Navigation grid spans too many tiles (%lld x %lld)"), NewSizeX, NewSizeY);
+
+		TArray<int32> NewDirectory;
+		NewDirectory.Init(INDEX_NONE, static_cast<int32>(NewSizeX * NewSizeY));
+		for (int64 OldY = 0; OldY < DirectorySizeY; ++OldY) {
+			for (int64 OldX = 0; OldX < DirectorySizeX; ++OldX) {
+				const int64 NewX = DirectoryMinX + OldX - NewMinX;
+				const int64 NewY = DirectoryMinY + OldY - NewMinY;
+				NewDirectory[NewY * NewSizeX + NewX] = TileDirectory[OldY * DirectorySizeX + OldX];
+			}
+		}
+
+		TileDirectory = MoveTemp(NewDirectory);
+		DirectoryMinX = NewMinX;
+		DirectoryMinY = NewMinY;
+		DirectorySizeX = NewSizeX;
+		DirectorySizeY = NewSizeY;
+	}
+
+	int32& TileId = TileDirectory[(TileY - DirectoryMinY) * DirectorySizeX + (TileX - DirectoryMinX)];
+	if (TileId == INDEX_NONE) {
+		checkf(Tiles.Num() < (1 << (32 - NodeSlotBits)), TEXT("Navigation grid has too many tiles"));
+
+		TileId = Tiles.AddDefaulted();
+		FTile& Tile = Tiles[TileId];
+		Tile.Id = TileId;
+		Tile.TileX = TileX;
+		Tile.TileY = TileY;
+		for (int16& Head : Tile.ColumnHeads) {
+			Head = INDEX_NONE;
+		}
+	}
+	return TileId;
 }
 
-void FNavGridAdjacencyList::AddNode(const FAdjacencyListIndex& Index)
+NavGrid::FNodeView FNavGridAdjacencyList::FTile::GetNodeView(const int32 Slot) const
 {
-	Nodes.Emplace(Index, NavGrid::FNode(Index));
+	const FTileNode& Node = Nodes[Slot];
+	return NavGrid::FNodeView {
+		MakeNodeId(Id, Slot),
+		GetNodeIndex(Slot),
+		GetOutEdges(Slot),
+		GetInNeighbors(Slot),
+		Node.DirectEdgeMask,
+		Node.bHasNonDirectEdges
+	};
 }
 
 TArray<FAdjacencyListIndex> FNavGridAdjacencyList::GetReachableNeighbors(const FAdjacencyListIndex& Index) const
 {
-	const auto NodeResult = GetNode(Index);
-	if (!NodeResult.has_value()) {
-		return {};
-	}
-	const auto Node = NodeResult->get();
+	TArray<FAdjacencyListIndex> Result;
+	ForEachReachableNeighbor(Index, [&Result](const FAdjacencyListIndex& Neighbor, double)
+	{
+		Result.Emplace(Neighbor);
+	});
+	return Result;
+}
 
+TArray<FAdjacencyListIndex> FNavGridAdjacencyList::GetReachingNeighbors(const FAdjacencyListIndex& Index) const
+{
 	TArray<FAdjacencyListIndex> Result;
-	for (const auto& Edge : Node.OutEdges) {
-		if (Edge.Type != NavGrid::Direct && Edge.Type != NavGrid::Slope && Edge.Type != NavGrid::SlopeBottom && Edge.Type != NavGrid::SlopeTop) {
-			continue;
+	ForEachReachingNeighbor(Index, [&Result](const FAdjacencyListIndex& Neighbor, double)
+	{
+		Result.Emplace(Neighbor);
+	});
+	return Result;
+}
+
+bool FNavGridAdjacencyList::GetDirectEdgeMask(const FAdjacencyListIndex& Index, uint8& OutMask, bool& bOutHasNonDirectEdges) const
+{
+	int32 Slot;
+	const FTile* Tile = FindTile(Index, Slot);
+	if (!Tile) {
+		return false;
+	}
+	OutMask = Tile->Nodes[Slot].DirectEdgeMask;
+	bOutHasNonDirectEdges = Tile->Nodes[Slot].bHasNonDirectEdges;
+	return true;
+}
+
+FNavGridAdjacencyList::FRegion FNavGridAdjacencyList::FRegion::FromWorldBounds(const FBox& Bounds)
+{
+	return { GridNavigatorConfig::WorldToGridIndex(Bounds.Min), GridNavigatorConfig::WorldToGridIndex(Bounds.Max) };
+}
+
+FNavGridAdjacencyList::FNodeIterator::FNodeIterator(const FNavGridAdjacencyList& NewList, const FRegion* NewRegion, const int32 NewTileIndex)
+	: List(&NewList), TileIndex(NewTileIndex)
+{
+	if (NewRegion) {
+		Region = *NewRegion;
+	}
+
+	// a region is walked through the tile directory cells under it, starting from the first cell with a tile
+	if (NewRegion && NewTileIndex < NewList.Tiles.Num()) {
+		const int64 MaxX = FMath::Min(NewRegion->Max.X >> TileShift, NewList.DirectoryMinX + NewList.DirectorySizeX - 1);
+		const int64 MaxY = FMath::Min(NewRegion->Max.Y >> TileShift, NewList.DirectoryMinY + NewList.DirectorySizeY - 1);
+		CellMinX = FMath::Max(NewRegion->Min.X >> TileShift, NewList.DirectoryMinX);
+		CellMinY = FMath::Max(NewRegion->Min.Y >> TileShift, NewList.DirectoryMinY);
+		NumCellsX = FMath::Max<int64>(MaxX - CellMinX + 1, 0);
+		NumCells = NumCellsX * FMath::Max<int64>(MaxY - CellMinY + 1, 0);
+		TileIndex = FindNextTileInRegion();
+	}
+	SkipToRegion();
+}
+
+FNavGridAdjacencyList::FNodeIterator& FNavGridAdjacencyList::FNodeIterator::operator++()
+{
+	++Slot;
+	SkipToRegion();
+	return *this;
+}
+
+void FNavGridAdjacencyList::FNodeIterator::SkipToRegion()
+{
+	const TArray<FTile>& Tiles = List->Tiles;
+	if (!Region.IsSet()) {
+		for (; TileIndex < Tiles.Num(); ++TileIndex, Slot = 0) {
+			if (Slot < Tiles[TileIndex].Nodes.Num()) {
+				return;
+			}
 		}
-		Result.Emplace(Edge.OutIndex);
+		return;
 	}
-	return Result;
+
+	// tiles that lie outside the region are never visited, so only the nodes of tiles it partly covers are checked
+	while (TileIndex < Tiles.Num()) {
+		const FTile& Tile = Tiles[TileIndex];
+		for (; Slot < Tile.Nodes.Num(); ++Slot) {
+			if (Region->Contains(Tile.GetNodeIndex(Slot))) {
+				return;
+			}
+		}
+		TileIndex = FindNextTileInRegion();
+		Slot = 0;
+	}
+}
+
+int32 FNavGridAdjacencyList::FNodeIterator::FindNextTileInRegion()
+{
+	for (; NextCell < NumCells; ++NextCell) {
+		const int64 DirectoryX = CellMinX + NextCell % NumCellsX - List->DirectoryMinX;
+		const int64 DirectoryY = CellMinY + NextCell / NumCellsX - List->DirectoryMinY;
+		const int32 TileId = List->TileDirectory[DirectoryY * List->DirectorySizeX + DirectoryX];
+		if (TileId != INDEX_NONE) {
+			++NextCell;
+			return TileId;
+		}
+	}
+	return List->Tiles.Num();
 }
 
-TArray<NavGrid::FNode> FNavGridAdjacencyList::GetNodeList()
+FNavGridAdjacencyList::FEdgeIterator::FEdgeIterator(const FNodeIterator& NewNode, const FNodeIterator& NewNodeEnd)
+	: Node(NewNode), NodeEnd(NewNodeEnd), NodeView()
 {
-	TArray<NavGrid::FNode> Output;
-	for (const auto& [ID, Node] : Nodes) {
-		Output.Add(Node);
+	SkipToEdge();
+}
+
+FNavGridAdjacencyList::FEdgeIterator& FNavGridAdjacencyList::FEdgeIterator::operator++()
+{
+	if (++EdgeIndex == NodeView.OutEdges.Num()) {
+		EdgeIndex = 0;
+		++Node;
+		SkipToEdge();
 	}
-	return Output;
+	return *this;
 }
 
-TArray<NavGrid::FEdge> FNavGridAdjacencyList::GetEdgeList()
+void FNavGridAdjacencyList::FEdgeIterator::SkipToEdge()
 {
-	TArray<NavGrid::FEdge> Output;
-	for (const auto [ID, Node] : Nodes) {
-		Output.Append(Node.OutEdges);
+	for (; Node != NodeEnd; ++Node) {
+		NodeView = *Node;
+		if (!NodeView.OutEdges.IsEmpty()) {
+			return;
+		}
 	}
-	return Output;
 }
 
-void FNavGridAdjacencyList::CreateEdge(const FAdjacencyListIndex& FromIndex, const FAdjacencyListIndex& ToIndex, const NavGrid::EMapEdgeType EdgeType)
+FNavGridAdjacencyList::FNodeRange FNavGridAdjacencyList::GetNodes() const
+{
+	checkf(!HasPendingEdges(), TEXT("The adjacency list must be compacted before its nodes are streamed"));
+	return FNodeRange(FNodeIterator(*this, nullptr, 0), FNodeIterator(*this, nullptr, Tiles.Num()));
+}
+
+FNavGridAdjacencyList::FNodeRange FNavGridAdjacencyList::GetNodes(const FRegion& Region) const
+{
+	checkf(!HasPendingEdges(), TEXT("The adjacency list must be compacted before its nodes are streamed"));
+	return FNodeRange(FNodeIterator(*this, &Region, 0), FNodeIterator(*this, &Region, Tiles.Num()));
+}
+
+FNavGridAdjacencyList::FEdgeRange FNavGridAdjacencyList::GetEdges() const
+{
+	const FNodeRange Nodes = GetNodes();
+	return FEdgeRange(FEdgeIterator(Nodes.begin(), Nodes.end()), FEdgeIterator(Nodes.end(), Nodes.end()));
+}
+
+FNavGridAdjacencyList::FEdgeRange FNavGridAdjacencyList::GetEdges(const FRegion& Region) const
+{
+	const FNodeRange Nodes = GetNodes(Region);
+	return FEdgeRange(FEdgeIterator(Nodes.begin(), Nodes.end()), FEdgeIterator(Nodes.end(), Nodes.end()));
+}
+
+void FNavGridAdjacencyList::CreateEdge(const FAdjacencyListIndex& FromIndex, const FAdjacencyListIndex& ToIndex, const NavGrid::EMapEdgeType EdgeType, const float MidpointHeight)
+{
+	AddNode(FromIndex);
+	AddNode(ToIndex);
+
+	const int16 MidpointHeightOffset = NavGrid::FEdge::GetMidpointHeightOffset(FromIndex, ToIndex, MidpointHeight);
+	const std::optional<NavGrid::FPackedEdge> Edge = NavGrid::FPackedEdge::Pack(FromIndex, ToIndex, EdgeType, MidpointHeightOffset);
+
+	// the build only joins horizontal neighbors, and only cliffs can be taller than a packed edge reaches
+	if (!Edge.has_value()) {
+		checkf(!NavGrid::IsTraversableEdgeType(EdgeType), TEXT("Cannot store a traversable edge from (%lld, %lld, %lld) to (%lld, %lld, %lld)"),
+			FromIndex.X, FromIndex.Y, FromIndex.Z, ToIndex.X, ToIndex.Y, ToIndex.Z);
+		UE_LOG(LogNavGridAdjacencyList, Verbose, TEXT("Dropped an untraversable edge from (%lld, %lld, %lld) to (%lld, %lld, %lld) that is too tall to store"),
+			FromIndex.X, FromIndex.Y, FromIndex.Z, ToIndex.X, ToIndex.Y, ToIndex.Z);
+		return;
+	}
+	AddEdge(FromIndex, *Edge);
+}
+
+void FNavGridAdjacencyList::AddEdge(const FAdjacencyListIndex& FromIndex, const NavGrid::FPackedEdge Edge)
+{
+	int32 FromSlot;
+	FTile* FromTile = FindTile(FromIndex, FromSlot);
+	check(FromTile);
+
+	const auto MarkPending = [this](FTile& Tile)
+	{
+		if (Tile.PendingEdges.IsEmpty() && Tile.PendingInNeighbors.IsEmpty()) {
+			PendingTiles.Add(Tile.Id);
+		}
+	};
+
+	AddEdgeToDirectionSummary(FromTile->Nodes[FromSlot], Edge);
+	const bool bIsTraversable = NavGrid::IsTraversableEdgeType(Edge.GetType());
+	const NavGrid::FNodeId FromId = MakeNodeId(FromTile->Id, FromSlot);
+	const FAdjacencyListIndex ToIndex = Edge.GetTarget(FromIndex);
+
+	MarkPending(*FromTile);
+	FromTile->PendingEdges.Emplace(FromSlot, Edge);
+
+	int32 ToSlot;
+	FTile* ToTile = FindTile(ToIndex, ToSlot);
+	if (!ToTile || !bIsTraversable) {
+		return;
+	}
+
+	MarkPending(*ToTile);
+	ToTile->PendingInNeighbors.Emplace(ToSlot, FromId);
+}
+
+void FNavGridAdjacencyList::Compact()
+{
+	ParallelFor(PendingTiles.Num(), [this](const int32 PendingIndex)
+	{
+		Tiles[PendingTiles[PendingIndex]].Compact();
+	});
+	PendingTiles.Reset();
+}
+
+void FNavGridAdjacencyList::FTile::Compact()
+{
+	// merges the pending entries into each node's range, keeping the nodes' entries in the order they were added
+	const auto Merge = [this]<typename ValueT>(TArray<ValueT>& Values, TArray<TPair<int32, ValueT>>& PendingValues, int32 FTileNode::* First)
+	{
+		if (PendingValues.IsEmpty()) {
+			return;
+		}
+		PendingValues.StableSort([](const TPair<int32, ValueT>& Lhs, const TPair<int32, ValueT>& Rhs)
+		{
+			return Lhs.Key < Rhs.Key;
+		});
+
+		TArray<ValueT> Merged;
+		Merged.Reserve(Values.Num() + PendingValues.Num());
+		int32 PendingIndex = 0;
+		for (int32 Slot = 0; Slot < Nodes.Num(); ++Slot) {
+			const int32 OldFirst = Nodes[Slot].*First;
+			const int32 OldEnd = Slot + 1 < Nodes.Num() ? Nodes[Slot + 1].*First : Values.Num();
+
+			Nodes[Slot].*First = Merged.Num();
+			for (int32 Index = OldFirst; Index < OldEnd; ++Index) {
+				Merged.Add(MoveTemp(Values[Index]));
+			}
+			for (; PendingIndex < PendingValues.Num() && PendingValues[PendingIndex].Key == Slot; ++PendingIndex) {
+				Merged.Add(MoveTemp(PendingValues[PendingIndex].Value));
+			}
+		}
+
+		Values = MoveTemp(Merged);
+		PendingValues.Empty();
+	};
+
+	Merge(Edges, PendingEdges, &FTileNode::FirstEdge);
+	Merge(InNeighbors, PendingInNeighbors, &FTileNode::FirstInNeighbor);
+}
+
+std::optional<NavGrid::FEdge> FNavGridAdjacencyList::FindTraversableEdge(const FAdjacencyListIndex& FromIndex, const FAdjacencyListIndex& ToIndex) const
 {
-	if (!HasNode(FromIndex)) {
-		AddNode(FromIndex);
+	int32 FromSlot;
+	const FTile* FromTile = FindTile(FromIndex, FromSlot);
+	if (!FromTile) {
+		return std::nullopt;
 	}
-	if (!HasNode(ToIndex)) {
-		AddNode(ToIndex);
+	for (const NavGrid::FPackedEdge Edge : FromTile->GetOutEdges(FromSlot)) {
+		if (NavGrid::IsTraversableEdgeType(Edge.GetType()) && Edge.GetTarget(FromIndex) == ToIndex) {
+			return Edge.Unpack(FromIndex);
+		}
 	}
+	return std::nullopt;
+}
 
-	const FVector Direction(ToIndex.X - FromIndex.X, ToIndex.Y - FromIndex.Y, ToIndex.Z - FromIndex.Z);
+void FNavGridAdjacencyList::AddEdgeToDirectionSummary(FTileNode& Node, const NavGrid::FPackedEdge Edge)
+{
+	if (!NavGrid::IsTraversableEdgeType(Edge.GetType())) {
+		return;
+	}
 
-	Nodes[FromIndex].OutEdges.Emplace(FromIndex, ToIndex, EdgeType, Direction);
+	if (Edge.GetType() == NavGrid::Direct && Edge.GetDeltaZ() == 0) {
+		Node.DirectEdgeMask |= 1 << Edge.GetDirection();
+	}
+	else {
+		Node.bHasNonDirectEdges = true;
+	}
 }
 
 bool FNavGridAdjacencyList::IsEdgeTraversable(const NavGrid::FEdge& Edge) const
 {
-	const bool IsTraversableType = Edge.Type == NavGrid::Direct || Edge.Type == NavGrid::Slope || Edge.Type == NavGrid::SlopeBottom || Edge.Type == NavGrid::SlopeTop;
-	const bool IsSourceNodeValid = Nodes.Contains(Edge.InIndex);
-	const bool IsTargetNodeValid = Nodes.Contains(Edge.OutIndex);
+	const bool IsTraversableType = NavGrid::IsTraversableEdgeType(Edge.Type);
+	const bool IsSourceNodeValid = HasNode(Edge.InIndex);
+	const bool IsTargetNodeValid = HasNode(Edge.OutIndex);
 
 	return IsTraversableType && IsSourceNodeValid && IsTargetNodeValid;
 }
 
 void FNavGridAdjacencyList::Clear()
 {
-	this->Nodes.Empty();
+	Tiles.Empty();
+	TileDirectory.Empty();
+	PendingTiles.Empty();
+	DirectoryMinX = 0;
+	DirectoryMinY = 0;
+	DirectorySizeX = 0;
+	DirectorySizeY = 0;
+	NumNodes = 0;
+}
+
+void FNavGridAdjacencyList::GetChangedNodes(const FNavGridAdjacencyList& Before, const FNavGridAdjacencyList& After, TArray<FAdjacencyListIndex>& OutChangedNodes)
+{
+	OutChangedNodes.Reset();
+
+	// every traversable target of one node is also a traversable target of the other
+	const auto HasTraversableTargetsOf = [](const NavGrid::FNodeView& Lhs, const NavGrid::FNodeView& Rhs)
+	{
+		for (const NavGrid::FPackedEdge LhsEdge : Lhs.OutEdges) {
+			if (!NavGrid::IsTraversableEdgeType(LhsEdge.GetType())) {
+				continue;
+			}
+			const bool bHasMatch = Rhs.OutEdges.ContainsByPredicate([LhsEdge](const NavGrid::FPackedEdge RhsEdge)
+			{
+				return NavGrid::IsTraversableEdgeType(RhsEdge.GetType()) && RhsEdge.HasSameTarget(LhsEdge);
+			});
+			if (!bHasMatch) {
+				return false;
+			}
+		}
+		return true;
+	};
+
+	// an edge's cost follows from its target, so edges to the same neighbor always cost the same; compared as
+	// sets both ways rather than by count, so that a repeated edge cannot stand in for a missing one
+	const auto HasSameTraversableEdges = [&HasTraversableTargetsOf](const NavGrid::FNodeView& Lhs, const NavGrid::FNodeView& Rhs)
+	{
+		return HasTraversableTargetsOf(Lhs, Rhs) && HasTraversableTargetsOf(Rhs, Lhs);
+	};
+
+	Before.ForEachNode([&](const NavGrid::FNodeView& BeforeNode)
+	{
+		const std::optional<NavGrid::FNodeView> AfterNode = After.GetNode(BeforeNode.Index);
+		if (!AfterNode.has_value() || !HasSameTraversableEdges(BeforeNode, *AfterNode)) {
+			OutChangedNodes.Add(BeforeNode.Index);
+		}
+	});
+	After.ForEachNode([&](const NavGrid::FNodeView& AfterNode)
+	{
+		if (!Before.HasNode(AfterNode.Index)) {
+			OutChangedNodes.Add(AfterNode.Index);
+		}
+	});
 }
 
 FString FNavGridAdjacencyList::Stringify()
@@ -119,9 +479,11 @@ FString FNavGridAdjacencyList::Stringify()
 
 	Output.Append(TEXT("Map has structure:\r\n"));
 
-	for (const auto& [Index, Node] : Nodes) {
+	ForEachNode([&Output](const NavGrid::FNodeView& Node)
+	{
 		Output.Appendf(TEXT("\tNode (%lld, %lld, %lld) has outward edges:\r\n"), Node.Index.X, Node.Index.Y, Node.Index.Z);
-		for (const auto& [InIndex, OutIndex, Type, Direction] : Node.OutEdges) {
+		for (const NavGrid::FPackedEdge Edge : Node.OutEdges) {
+			const auto& [InIndex, OutIndex, Type, Direction, Cost, MidpointHeightOffset] = Edge.Unpack(Node.Index);
 			Output.Appendf(
 				TEXT("\t\tEdge from (%lld, %lld, %lld) to (%lld, %lld, %lld) | Dir: (%0.2f, %0.2f, %0.2f)\r\n"),
 				InIndex.X,  InIndex.Y,  InIndex.Z,
@@ -129,12 +491,95 @@ FString FNavGridAdjacencyList::Stringify()
 				Direction.X, Direction.Y, Direction.Z
 			);
 		}
-	}
+	});
 
 	return Output;
 }
 
+SIZE_T FNavGridAdjacencyList::GetAllocatedSize() const
+{
+	SIZE_T Size = Tiles.GetAllocatedSize() + TileDirectory.GetAllocatedSize();
+	for (const FTile& Tile : Tiles) {
+		Size += Tile.Nodes.GetAllocatedSize() + Tile.Edges.GetAllocatedSize() + Tile.InNeighbors.GetAllocatedSize();
+		Size += Tile.PendingEdges.GetAllocatedSize() + Tile.PendingInNeighbors.GetAllocatedSize();
+	}
+	return Size;
+}
+
 void FNavGridAdjacencyList::Serialize(FArchive& Archive)
 {
-	Archive << Nodes;
+	Archive.UsingCustomVersion(FGridNavigatorVersion::GUID);
+
+	if (Archive.IsLoading()) {
+		Clear();
+		if (Archive.CustomVer(FGridNavigatorVersion::GUID) < FGridNavigatorVersion::PackedEdges) {
+			LoadUnpacked(Archive);
+			return;
+		}
+
+		int32 NumStoredNodes = 0;
+		Archive << NumStoredNodes;
+
+		TArray<TPair<FAdjacencyListIndex, TArray<NavGrid::FPackedEdge>>> StoredNodes;
+		StoredNodes.SetNum(NumStoredNodes);
+		for (auto& [Index, Edges] : StoredNodes) {
+			Archive << Index;
+			Archive << Edges;
+			AddNode(Index);
+		}
+		for (const auto& [Index, Edges] : StoredNodes) {
+			for (const NavGrid::FPackedEdge Edge : Edges) {
+				AddEdge(Index, Edge);
+			}
+		}
+		Compact();
+	}
+	else {
+		checkf(!HasPendingEdges(), TEXT("Compact the adjacency list before saving it"));
+
+		// the direction summaries and incoming edges are derived data, so they are rebuilt rather than stored
+		int32 NumStoredNodes = NumNodes;
+		Archive << NumStoredNodes;
+		ForEachNode([&Archive](const NavGrid::FNodeView& View)
+		{
+			FAdjacencyListIndex Index = View.Index;
+			TArray<NavGrid::FPackedEdge> Edges(View.OutEdges.GetData(), View.OutEdges.Num());
+			Archive << Index;
+			Archive << Edges;
+		});
+	}
+}
+
+void FNavGridAdjacencyList::LoadUnpacked(FArchive& Archive)
+{
+	// laid out the way a TMap of index to node serializes: a count, then each index and node
+	int32 NumStoredNodes = 0;
+	Archive << NumStoredNodes;
+
+	TArray<FUnpackedNode> StoredNodes;
+	StoredNodes.SetNum(NumStoredNodes);
+	for (FUnpackedNode& Node : StoredNodes) {
+		FAdjacencyListIndex Index;
+		Archive << Index;
+		Archive << Node;
+		AddNode(Index);
+	}
+
+	int32 NumDropped = 0;
+	for (const FUnpackedNode& Node : StoredNodes) {
+		for (const NavGrid::FEdge& Edge : Node.OutEdges) {
+			const std::optional<NavGrid::FPackedEdge> Packed = NavGrid::FPackedEdge::Pack(Edge);
+			if (!Packed.has_value()) {
+				++NumDropped;
+			}
+			else if (HasNode(Edge.InIndex)) {
+				AddEdge(Edge.InIndex, *Packed);
+			}
+		}
+	}
+	Compact();
+
+	if (NumDropped > 0) {
+		UE_LOG(LogNavGridAdjacencyList, Warning, TEXT("Dropped %d stored edges that do not lead to a horizontal neighbor; rebuild navigation to restore them"), NumDropped);
+	}
 }
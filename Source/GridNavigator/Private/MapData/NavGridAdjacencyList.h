@@ -3,29 +3,510 @@
 
 #include "NavGridAdjacencyListTypes.h"
 
+/**
+ * @class FNavGridAdjacencyList
+ * @brief The navigation graph: every walkable grid node and the edges between them.
+ *
+ * Nodes are stored in square tiles of TileSize x TileSize columns, each holding the few nodes stacked at different
+ * heights in that column. A tile keeps its nodes, their edges and their incoming neighbors in contiguous arrays of
+ * its own, and the tiles are found through a dense directory covering every tile between the smallest and largest
+ * ones in use, so finding a node takes a few array reads rather than hashing its index. Edges are kept packed into
+ * 32 bits each (see NavGrid::FPackedEdge), and only unpacked into full FEdge records when asked for.
+ *
+ * Edges are appended to a tile as they are created and only sorted into place by Compact, which must be called
+ * once a batch of edges has been created and before the edges are queried.
+ *
+ * Each node also has a compact 32-bit ID (see FindNodeId), which stays valid until the list is cleared.
+ */
 class FNavGridAdjacencyList
 {
+	struct FTile;
+
 public:
-	std::optional<std::reference_wrapper<const NavGrid::FNode>> GetNode(const int64 X, const int64 Y, const int64 Z) const;
-	std::optional<std::reference_wrapper<const NavGrid::FNode>> GetNode(const NavGrid::FAdjacencyListIndex& Index) const;
-	FORCEINLINE bool HasNode(const int X, const int Y, const int Z) const;
-	FORCEINLINE bool HasNode(const NavGrid::FAdjacencyListIndex& Index) const;
-	FORCEINLINE void AddNode(const int64 X, const int64 Y, const int64 Z);
-	FORCEINLINE void AddNode(const NavGrid::FAdjacencyListIndex& Index);
+	/**
+	 * @brief A box of grid indices, inclusive on every side, that node and edge ranges can be limited to.
+	 */
+	struct FRegion
+	{
+		NavGrid::FAdjacencyListIndex Min;
+		NavGrid::FAdjacencyListIndex Max;
+
+		FORCEINLINE bool Contains(const NavGrid::FAdjacencyListIndex& Index) const
+		{
+			return Index.X >= Min.X && Index.Y >= Min.Y && Index.Z >= Min.Z && Index.X <= Max.X && Index.Y <= Max.Y && Index.Z <= Max.Z;
+		}
+
+		/**
+		 * @return The grid indices inside a world space box, rounded the same way the grid is built over a block
+		 */
+		static FRegion FromWorldBounds(const FBox& Bounds);
+	};
+
+	/**
+	 * @brief Walks the nodes of the list, optionally only the ones inside a region, handing out views of them
+	 * without copying anything. A region is walked through the tile directory, so only the tiles under it are
+	 * visited, however large the rest of the list is.
+	 */
+	class FNodeIterator
+	{
+	public:
+		FNodeIterator(const FNavGridAdjacencyList& NewList, const FRegion* NewRegion, int32 NewTileIndex);
+
+		FORCEINLINE NavGrid::FNodeView operator*() const { return List->Tiles[TileIndex].GetNodeView(Slot); }
+		FORCEINLINE bool operator!=(const FNodeIterator& Rhs) const { return TileIndex != Rhs.TileIndex || Slot != Rhs.Slot; }
+		FNodeIterator& operator++();
+
+	private:
+		/**
+		 * @brief Moves forward from the current position to the first node inside the region, if it is not inside already.
+		 */
+		void SkipToRegion();
+
+		/**
+		 * @return The ID of the next tile under the region, in directory order, or the number of tiles if there is none
+		 */
+		int32 FindNextTileInRegion();
+
+		const FNavGridAdjacencyList* List;
+		TOptional<FRegion> Region;
+		int32 TileIndex;
+		int32 Slot = 0;
+
+		// rectangle of the tile directory that lies under the region, and the next of its cells to look at
+		int64 CellMinX = 0;
+		int64 CellMinY = 0;
+		int64 NumCellsX = 0;
+		int64 NumCells = 0;
+		int64 NextCell = 0;
+	};
+
+	/**
+	 * @brief Walks the outgoing edges of the nodes an FNodeIterator walks, unpacking each one as it is reached.
+	 */
+	class FEdgeIterator
+	{
+	public:
+		FEdgeIterator(const FNodeIterator& NewNode, const FNodeIterator& NewNodeEnd);
+
+		FORCEINLINE NavGrid::FEdge operator*() const { return NodeView.OutEdges[EdgeIndex].Unpack(NodeView.Index); }
+		FORCEINLINE bool operator!=(const FEdgeIterator& Rhs) const { return Node != Rhs.Node || EdgeIndex != Rhs.EdgeIndex; }
+		FEdgeIterator& operator++();
+
+	private:
+		/**
+		 * @brief Moves forward from the current node to the first one that has an edge left to visit.
+		 */
+		void SkipToEdge();
+
+		FNodeIterator Node;
+		FNodeIterator NodeEnd;
+		NavGrid::FNodeView NodeView;
+		int32 EdgeIndex = 0;
+	};
+
+	/**
+	 * @brief A non-owning range of nodes or edges for range-based for loops; only valid while the list is left unchanged.
+	 */
+	template <typename IteratorT>
+	class TIteratorRange
+	{
+	public:
+		TIteratorRange(const IteratorT& NewFirst, const IteratorT& NewLast) : First(NewFirst), Last(NewLast) {}
+
+		FORCEINLINE IteratorT begin() const { return First; }
+		FORCEINLINE IteratorT end() const { return Last; }
+
+	private:
+		IteratorT First;
+		IteratorT Last;
+	};
+
+	typedef TIteratorRange<FNodeIterator> FNodeRange;
+	typedef TIteratorRange<FEdgeIterator> FEdgeRange;
+
+	std::optional<NavGrid::FNodeView> GetNode(const int64 X, const int64 Y, const int64 Z) const;
+	std::optional<NavGrid::FNodeView> GetNode(const NavGrid::FAdjacencyListIndex& Index) const;
+	FORCEINLINE bool HasNode(const int X, const int Y, const int Z) const
+	{
+		return HasNode(NavGrid::FAdjacencyListIndex(X, Y, Z));
+	}
+	FORCEINLINE bool HasNode(const NavGrid::FAdjacencyListIndex& Index) const
+	{
+		int32 Slot;
+		return FindTile(Index, Slot) != nullptr;
+	}
+	void AddNode(const int64 X, const int64 Y, const int64 Z);
+	void AddNode(const NavGrid::FAdjacencyListIndex& Index);
+
+	/**
+	 * @return The ID of the node at Index, or InvalidNodeId if there is no such node
+	 */
+	FORCEINLINE NavGrid::FNodeId FindNodeId(const NavGrid::FAdjacencyListIndex& Index) const
+	{
+		int32 Slot;
+		const FTile* Tile = FindTile(Index, Slot);
+		return Tile ? MakeNodeId(Tile->Id, Slot) : NavGrid::InvalidNodeId;
+	}
+
+	/**
+	 * @return The grid index of the node with an ID given out by this list
+	 */
+	FORCEINLINE NavGrid::FAdjacencyListIndex GetNodeIndex(const NavGrid::FNodeId Id) const
+	{
+		const FTile& Tile = Tiles[Id >> NodeSlotBits];
+		return Tile.GetNodeIndex(Id & NodeSlotMask);
+	}
+
+	FORCEINLINE int32 GetNumNodes() const { return NumNodes; }
 
 	TArray<NavGrid::FAdjacencyListIndex> GetReachableNeighbors(const NavGrid::FAdjacencyListIndex& Index) const;
+
+	/**
+	 * @brief Visits every node that can be reached from a node in a single step, without allocating.
+	 *
+	 * @param Index The node to query
+	 * @param Callable Invoked as Callable(const FAdjacencyListIndex& Neighbor, double EdgeCost) for each traversable edge
+	 */
+	template <typename CallableT>
+	void ForEachReachableNeighbor(const NavGrid::FAdjacencyListIndex& Index, CallableT&& Callable) const
+	{
+		int32 Slot;
+		const FTile* Tile = FindTile(Index, Slot);
+		if (!Tile) {
+			return;
+		}
+		for (const NavGrid::FPackedEdge Edge : Tile->GetOutEdges(Slot)) {
+			if (NavGrid::IsTraversableEdgeType(Edge.GetType())) {
+				Callable(Edge.GetTarget(Index), Edge.GetCost());
+			}
+		}
+	}
+
+	/**
+	 * @brief Retrieves every node that has a traversable edge leading into a node; the reverse of GetReachableNeighbors.
+	 *
+	 * @param Index The node to query
+	 * @return The nodes that can reach Index in a single step, or an empty array if Index does not exist
+	 */
+	TArray<NavGrid::FAdjacencyListIndex> GetReachingNeighbors(const NavGrid::FAdjacencyListIndex& Index) const;
+
+	/**
+	 * @brief Visits every node that has a traversable edge into a node, without allocating.
+	 *
+	 * @param Index The node to query
+	 * @param Callable Invoked as Callable(const FAdjacencyListIndex& Neighbor, double EdgeCost) for each incoming edge
+	 */
+	template <typename CallableT>
+	void ForEachReachingNeighbor(const NavGrid::FAdjacencyListIndex& Index, CallableT&& Callable) const
+	{
+		int32 Slot;
+		const FTile* Tile = FindTile(Index, Slot);
+		if (!Tile) {
+			return;
+		}
+		for (const NavGrid::FNodeId NeighborId : Tile->GetInNeighbors(Slot)) {
+			const NavGrid::FAdjacencyListIndex Neighbor = GetNodeIndex(NeighborId);
+			Callable(Neighbor, Distance(Neighbor, Index));
+		}
+	}
+
+	/**
+	 * @brief Retrieves the summary of a node's flat, same-height Direct edges used by jump point search.
+	 *
+	 * @param Index The node to query
+	 * @param OutMask Bit N is set if the node has a Direct edge to its same-height neighbor in direction N
+	 * @param bOutHasNonDirectEdges Set if the node has traversable edges that are not part of OutMask
+	 * @return \c true if the node exists; \c false otherwise
+	 */
+	bool GetDirectEdgeMask(const NavGrid::FAdjacencyListIndex& Index, uint8& OutMask, bool& bOutHasNonDirectEdges) const;
 	
-	TArray<NavGrid::FNode> GetNodeList();
-	TArray<NavGrid::FEdge> GetEdgeList();
+	/**
+	 * @brief Visits every node in the list, tile by tile.
+	 *
+	 * @param Callable Invoked as Callable(const FNodeView& Node) for each node
+	 */
+	template <typename CallableT>
+	void ForEachNode(CallableT&& Callable) const
+	{
+		for (const FTile& Tile : Tiles) {
+			for (int32 Slot = 0; Slot < Tile.Nodes.Num(); ++Slot) {
+				Callable(Tile.GetNodeView(Slot));
+			}
+		}
+	}
+
+	/**
+	 * @brief Streams every node of the list, tile by tile, without copying any of them.
+	 *
+	 * @return A range of FNodeView; the list must be compacted, and must not change while the range is in use
+	 */
+	FNodeRange GetNodes() const;
+
+	/**
+	 * @brief Streams the nodes inside a region, skipping the tiles that lie outside of it entirely.
+	 *
+	 * @return A range of FNodeView; the list must be compacted, and must not change while the range is in use
+	 */
+	FNodeRange GetNodes(const FRegion& Region) const;
+
+	/**
+	 * @brief Streams every edge of the list, unpacking each one only once it is reached.
+	 *
+	 * @return A range of FEdge; the list must be compacted, and must not change while the range is in use
+	 */
+	FEdgeRange GetEdges() const;
+
+	/**
+	 * @brief Streams the edges leading out of the nodes inside a region.
+	 *
+	 * @return A range of FEdge; the list must be compacted, and must not change while the range is in use
+	 */
+	FEdgeRange GetEdges(const FRegion& Region) const;
 	
-	void CreateEdge(const NavGrid::FAdjacencyListIndex& FromIndex, const NavGrid::FAdjacencyListIndex& ToIndex, const NavGrid::EMapEdgeType EdgeType);
+	/**
+	 * @brief Adds an edge between two nodes, adding either node if it does not exist yet.
+	 *
+	 * The nodes are visible straight away, but the edge is not until the next call to Compact.
+	 *
+	 * @param FromIndex The node the edge leads out of
+	 * @param ToIndex The node the edge leads into; must be a horizontal neighbor of FromIndex (see FPackedEdge)
+	 * @param EdgeType How the edge can be traversed
+	 * @param MidpointHeight World height of the floor halfway along the edge
+	 */
+	void CreateEdge(const NavGrid::FAdjacencyListIndex& FromIndex, const NavGrid::FAdjacencyListIndex& ToIndex, const NavGrid::EMapEdgeType EdgeType, float MidpointHeight);
+
+	/**
+	 * @brief Sorts every edge created since the last call into its node's range of its tile, so that it can be
+	 * queried. Tiles are independent of each other, so they are compacted in parallel.
+	 */
+	void Compact();
+
+	/**
+	 * @return \c true if edges have been created since the last call to Compact
+	 */
+	FORCEINLINE bool HasPendingEdges() const { return !PendingTiles.IsEmpty(); }
+
+	/**
+	 * @return The traversable edge from one node to another, unpacked, or an empty optional if there is no such edge
+	 */
+	std::optional<NavGrid::FEdge> FindTraversableEdge(const NavGrid::FAdjacencyListIndex& FromIndex, const NavGrid::FAdjacencyListIndex& ToIndex) const;
 	bool IsEdgeTraversable(const NavGrid::FEdge& Edge) const;
 	
 	void Clear();
 	FString Stringify();
 
+	/**
+	 * @brief Finds the nodes whose traversable outgoing edges differ between two versions of a map.
+	 *
+	 * Nodes that only exist in one of the maps are included, as are nodes whose traversable edges lead to
+	 * different neighbors or have different costs; the order of each node's edges is ignored.
+	 *
+	 * @param Before The map as it was before an edit
+	 * @param After The map as it is after the edit
+	 * @param OutChangedNodes Receives the changed nodes, in no particular order
+	 */
+	static void GetChangedNodes(const FNavGridAdjacencyList& Before, const FNavGridAdjacencyList& After, TArray<NavGrid::FAdjacencyListIndex>& OutChangedNodes);
+
+	/**
+	 * @return Number of bytes used by the nodes, edges and tile directory
+	 */
+	SIZE_T GetAllocatedSize() const;
+
+	/**
+	 * @brief Saves or loads the list with its edges packed. Data saved before edges were packed (see
+	 * FGridNavigatorVersion::PackedEdges) is loaded through the unpacked layout it was saved with.
+	 */
 	void Serialize(FArchive& Archive);
 
+	// width and depth, in grid cells, of the tiles that nodes are stored in
+	static constexpr int32 TileShift = 4;
+	static constexpr int32 TileSize = 1 << TileShift;
+
+private:
+	static constexpr int64 TileMask = TileSize - 1;
+	static constexpr int32 NumTileColumns = TileSize * TileSize;
+
+	// a node's ID holds its tile's ID in the upper bits and its slot within the tile in the lower bits
+	static constexpr int32 NodeSlotBits = 14;
+	static constexpr uint32 NodeSlotMask = (1u << NodeSlotBits) - 1;
+	static constexpr int32 MaxNodesPerTile = 1 << NodeSlotBits;
+
+	struct FTileNode
+	{
+		int32 Z = 0;
+
+		// the node's edges run from its FirstEdge to the next node's, and likewise for its incoming neighbors
+		int32 FirstEdge = 0;
+		int32 FirstInNeighbor = 0;
+
+		// next node up or down the same column, or INDEX_NONE
+		int16 NextInColumn = INDEX_NONE;
+		uint8 Column = 0;
+
+		uint8 DirectEdgeMask = 0;
+		bool bHasNonDirectEdges = false;
+	};
+
+	struct FTile
+	{
+		int32 Id = 0;
+		int64 TileX = 0;
+		int64 TileY = 0;
+
+		// slot of the first node in each column, or INDEX_NONE
+		int16 ColumnHeads[NumTileColumns];
+
+		TArray<FTileNode> Nodes;
+		TArray<NavGrid::FPackedEdge> Edges;
+		TArray<NavGrid::FNodeId> InNeighbors;
+
+		// created since the tile was last compacted, each with the slot of the node it belongs to
+		TArray<TPair<int32, NavGrid::FPackedEdge>> PendingEdges;
+		TArray<TPair<int32, NavGrid::FNodeId>> PendingInNeighbors;
+
+		FORCEINLINE int32 FindSlot(const NavGrid::FAdjacencyListIndex& Index) const
+		{
+			for (int32 Slot = ColumnHeads[GetColumn(Index.X, Index.Y)]; Slot != INDEX_NONE; Slot = Nodes[Slot].NextInColumn) {
+				if (Nodes[Slot].Z == Index.Z) {
+					return Slot;
+				}
+			}
+			return INDEX_NONE;
+		}
+
+		FORCEINLINE int32 GetEdgesEnd(const int32 Slot) const
+		{
+			return Slot + 1 < Nodes.Num() ? Nodes[Slot + 1].FirstEdge : Edges.Num();
+		}
+
+		FORCEINLINE int32 GetInNeighborsEnd(const int32 Slot) const
+		{
+			return Slot + 1 < Nodes.Num() ? Nodes[Slot + 1].FirstInNeighbor : InNeighbors.Num();
+		}
+
+		FORCEINLINE TConstArrayView<NavGrid::FPackedEdge> GetOutEdges(const int32 Slot) const
+		{
+			checkSlow(PendingEdges.IsEmpty());
+			const int32 First = Nodes[Slot].FirstEdge;
+			return MakeArrayView(Edges.GetData() + First, GetEdgesEnd(Slot) - First);
+		}
+
+		FORCEINLINE TConstArrayView<NavGrid::FNodeId> GetInNeighbors(const int32 Slot) const
+		{
+			checkSlow(PendingInNeighbors.IsEmpty());
+			const int32 First = Nodes[Slot].FirstInNeighbor;
+			return MakeArrayView(InNeighbors.GetData() + First, GetInNeighborsEnd(Slot) - First);
+		}
+
+		FORCEINLINE NavGrid::FAdjacencyListIndex GetNodeIndex(const int32 Slot) const
+		{
+			const FTileNode& Node = Nodes[Slot];
+			return NavGrid::FAdjacencyListIndex((TileX << TileShift) | (Node.Column & TileMask), (TileY << TileShift) | (Node.Column >> TileShift), Node.Z);
+		}
+
+		NavGrid::FNodeView GetNodeView(int32 Slot) const;
+
+		void Compact();
+	};
+
+	FORCEINLINE static int32 GetColumn(const int64 X, const int64 Y)
+	{
+		return static_cast<int32>(((Y & TileMask) << TileShift) | (X & TileMask));
+	}
+
+	FORCEINLINE static NavGrid::FNodeId MakeNodeId(const int32 TileId, const int32 Slot)
+	{
+		return (static_cast<uint32>(TileId) << NodeSlotBits) | static_cast<uint32>(Slot);
+	}
+
+	/**
+	 * @return The tile holding the node at Index, with the node's slot in OutSlot, or nullptr if there is no such node
+	 */
+	FORCEINLINE const FTile* FindTile(const NavGrid::FAdjacencyListIndex& Index, int32& OutSlot) const
+	{
+		const int64 DirectoryX = (Index.X >> TileShift) - DirectoryMinX;
+		const int64 DirectoryY = (Index.Y >> TileShift) - DirectoryMinY;
+		if (DirectoryX < 0 || DirectoryY < 0 || DirectoryX >= DirectorySizeX || DirectoryY >= DirectorySizeY) {
+			return nullptr;
+		}
+
+		const int32 TileId = TileDirectory[DirectoryY * DirectorySizeX + DirectoryX];
+		if (TileId == INDEX_NONE) {
+			return nullptr;
+		}
+
+		const FTile& Tile = Tiles[TileId];
+		OutSlot = Tile.FindSlot(Index);
+		return OutSlot != INDEX_NONE ? &Tile : nullptr;
+	}
+
+	FTile* FindTile(const NavGrid::FAdjacencyListIndex& Index, int32& OutSlot)
+	{
+		return const_cast<FTile*>(static_cast<const FNavGridAdjacencyList*>(this)->FindTile(Index, OutSlot));
+	}
+
+	/**
+	 * @return The ID of the tile covering a column, adding the tile (and growing the directory to cover it) if needed
+	 */
+	int32 FindOrAddTile(int64 X, int64 Y);
+
+	/**
+	 * @brief Queues an edge out of an existing node, along with the matching incoming neighbor of its target node.
+	 */
+	void AddEdge(const NavGrid::FAdjacencyListIndex& FromIndex, NavGrid::FPackedEdge Edge);
+
+	static void AddEdgeToDirectionSummary(FTileNode& Node, NavGrid::FPackedEdge Edge);
+
+	/**
+	 * @brief Loads navigation data saved before edges were packed, which stored a map of nodes holding unpacked
+	 * edges, and packs its edges.
+	 */
+	void LoadUnpacked(FArchive& Archive);
+
+	TArray<FTile> Tiles;
+
+	// ID of every tile in a rectangle of DirectorySizeX x DirectorySizeY tiles, or INDEX_NONE where there is none
+	TArray<int32> TileDirectory;
+	int64 DirectoryMinX = 0;
+	int64 DirectoryMinY = 0;
+	int64 DirectorySizeX = 0;
+	int64 DirectorySizeY = 0;
+
+	// IDs of the tiles with edges waiting to be compacted
+	TArray<int32> PendingTiles;
+
+	int32 NumNodes = 0;
+};
+
+/**
+ * @class FNavGridReverseAdjacencyView
+ * @brief Presents an adjacency list with every edge reversed, so that searches over it run from the goal
+ * back towards the start.
+ *
+ * Satisfies can_query_nodes, so it can be handed to any of the search templates in place of the map itself.
+ * The view only references the map, which must outlive it.
+ */
+class FNavGridReverseAdjacencyView
+{
+public:
+	explicit FNavGridReverseAdjacencyView(const FNavGridAdjacencyList& NewMap) : Map(&NewMap) {}
+
+	FORCEINLINE bool HasNode(const int64 X, const int64 Y, const int64 Z) const
+	{
+		return Map->HasNode(NavGrid::FAdjacencyListIndex(X, Y, Z));
+	}
+
+	FORCEINLINE bool HasNode(const NavGrid::FAdjacencyListIndex& Index) const
+	{
+		return Map->HasNode(Index);
+	}
+
+	template <typename CallableT>
+	FORCEINLINE void ForEachReachableNeighbor(const NavGrid::FAdjacencyListIndex& Index, CallableT&& Callable) const
+	{
+		Map->ForEachReachingNeighbor(Index, Forward<CallableT>(Callable));
+	}
+
 private:
-	TMap<NavGrid::FAdjacencyListIndex, NavGrid::FNode> Nodes;
+	const FNavGridAdjacencyList* Map;
 };
@@ -1,18 +1,69 @@
 #include "NavGridAdjacencyListTypes.h"
 
+#include "GridNavigatorConfig.h"
+
 namespace NavGrid
 {
-	FNode::FNode() : Index(0) {}
-	FNode::FNode(const FAdjacencyListIndex& NewIndex) : Index(NewIndex) {}
+	namespace
+	{
+		// world height halfway between an edge's endpoints, going by their grid heights alone
+		double GetGridMidpointHeight(const FAdjacencyListIndex& InIndex, const FAdjacencyListIndex& OutIndex)
+		{
+			return static_cast<double>(InIndex.Z + OutIndex.Z) * GridNavigatorConfig::GridSizeZ / 2.0;
+		}
+	}
 
-	bool FNode::operator==(const FNode& Rhs) const
+	std::optional<FPackedEdge> FPackedEdge::Pack(const FAdjacencyListIndex& FromIndex, const FAdjacencyListIndex& ToIndex, const EMapEdgeType Type, const int16 MidpointHeightOffset)
 	{
-		return Index.X == Rhs.Index.X && Index.Y == Rhs.Index.Y && Index.Z == Rhs.Index.Z;
+		const int32 Direction = GetDirectionIndex(ToIndex.X - FromIndex.X, ToIndex.Y - FromIndex.Y);
+		const int64 DeltaZ = ToIndex.Z - FromIndex.Z;
+		if (Direction == INDEX_NONE || DeltaZ < MinDeltaZ || DeltaZ > MaxDeltaZ) {
+			return std::nullopt;
+		}
+
+		FPackedEdge Result;
+		Result.Bits = static_cast<uint32>(Direction)
+			| (static_cast<uint32>(Type) & 0x7u) << 3
+			| (static_cast<uint32>(DeltaZ) & ((1u << DeltaZBits) - 1)) << 6
+			| static_cast<uint32>(static_cast<uint16>(MidpointHeightOffset)) << 16;
+		return Result;
+	}
+
+	std::optional<FPackedEdge> FPackedEdge::Pack(const FEdge& Edge)
+	{
+		return Pack(Edge.InIndex, Edge.OutIndex, Edge.Type, Edge.MidpointHeightOffset);
+	}
+
+	FEdge FPackedEdge::Unpack(const FAdjacencyListIndex& FromIndex) const
+	{
+		const FAdjacencyListIndex ToIndex = GetTarget(FromIndex);
+		const FVector Direction(ToIndex.X - FromIndex.X, ToIndex.Y - FromIndex.Y, ToIndex.Z - FromIndex.Z);
+
+		FEdge Result(FromIndex, ToIndex, GetType(), Direction, 0.f);
+		Result.MidpointHeightOffset = GetMidpointHeightOffset();
+		return Result;
+	}
+
+	FEdge::FEdge() : InIndex(0), OutIndex(0), Type(None), Direction(0, 0, 0), Cost(0.0), MidpointHeightOffset(0) {}
+	FEdge::FEdge(const FAdjacencyListIndex& NewInIndex, const FAdjacencyListIndex& NewOutIndex, const EMapEdgeType NewType, const FVector& NewDirection, const float MidpointHeight)
+		: InIndex(NewInIndex), OutIndex(NewOutIndex), Type(NewType), Direction(NewDirection), Cost(Distance(NewInIndex, NewOutIndex))
+	{
+		MidpointHeightOffset = GetMidpointHeightOffset(NewInIndex, NewOutIndex, MidpointHeight);
+	}
+
+	int16 FEdge::GetMidpointHeightOffset(const FAdjacencyListIndex& InIndex, const FAdjacencyListIndex& OutIndex, const float MidpointHeight)
+	{
+		const double Offset = (MidpointHeight - GetGridMidpointHeight(InIndex, OutIndex)) * 100.0;
+		return static_cast<int16>(FMath::Clamp<int32>(FMath::RoundToInt32(Offset), MIN_int16, MAX_int16));
+	}
+
+	FVector FEdge::GetMidpoint() const
+	{
+		const FVector InLocation = GridNavigatorConfig::GridIndexToWorld(InIndex);
+		const FVector OutLocation = GridNavigatorConfig::GridIndexToWorld(OutIndex);
+		const double Height = GetGridMidpointHeight(InIndex, OutIndex) + MidpointHeightOffset / 100.0;
+		return FVector((InLocation.X + OutLocation.X) / 2.0, (InLocation.Y + OutLocation.Y) / 2.0, Height);
 	}
-			
-	FEdge::FEdge() : InIndex(0), OutIndex(0), Type(None), Direction(0, 0, 0) {}
-	FEdge::FEdge(const FAdjacencyListIndex& NewInIndex, const FAdjacencyListIndex& NewOutIndex, const EMapEdgeType NewType, const FVector& NewDirection)
-		: InIndex(NewInIndex), OutIndex(NewOutIndex), Type(NewType), Direction(NewDirection) {}
 			
 	FString FEdge::ToString() const
 	{
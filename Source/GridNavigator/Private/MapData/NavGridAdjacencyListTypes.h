@@ -1,4 +1,8 @@
 #pragma once
+#include <optional>
+
+#include "GridNavigatorVersion.h"
+#include "Navigation/GridDistance.h"
 
 namespace NavGrid
 {
@@ -12,44 +16,178 @@ namespace NavGrid
 		SlopeTop,
 	};
 
+	FORCEINLINE bool IsTraversableEdgeType(const EMapEdgeType Type)
+	{
+		return Type == Direct || Type == Slope || Type == SlopeBottom || Type == SlopeTop;
+	}
+
 	struct FEdge;
 
 	typedef FInt64Vector3 FAdjacencyListIndex;
+
+	// compact handle of a node stored in an FNavGridAdjacencyList; stays valid until the list is cleared
+	typedef uint32 FNodeId;
+	inline constexpr FNodeId InvalidNodeId = TNumericLimits<uint32>::Max();
+
+	// the eight horizontal neighbor offsets, counter-clockwise from +X; bit N of a direction mask refers to entry N
+	inline constexpr int32 NumDirections = 8;
+	inline constexpr int32 DirectionOffsetX[NumDirections] = { 1, 1, 0, -1, -1, -1,  0,  1 };
+	inline constexpr int32 DirectionOffsetY[NumDirections] = { 0, 1, 1,  1,  0, -1, -1, -1 };
+
+	/**
+	 * @brief Maps a horizontal neighbor offset onto its direction index.
+	 *
+	 * @return Index into DirectionOffsetX/DirectionOffsetY, or INDEX_NONE if the offset is not a unit step
+	 */
+	FORCEINLINE int32 GetDirectionIndex(const int64 DX, const int64 DY)
+	{
+		static constexpr int32 Lookup[3][3] = {
+			{ 5, 4, 3 },
+			{ 6, INDEX_NONE, 2 },
+			{ 7, 0, 1 },
+		};
+		if (DX < -1 || DX > 1 || DY < -1 || DY > 1) {
+			return INDEX_NONE;
+		}
+		return Lookup[DX + 1][DY + 1];
+	}
+
+	FORCEINLINE bool IsDiagonalDirection(const int32 Direction)
+	{
+		return (Direction & 1) != 0;
+	}
 		
-	struct FNode
+	/**
+	 * @brief An edge as FNavGridAdjacencyList stores it, packed into 32 bits.
+	 *
+	 * Every edge leads to one of the eight horizontal neighbors of the node it leaves, so the edge only needs to
+	 * record which one (3 bits), its type (3 bits), the height difference to the neighbor in grid cells (10 bits,
+	 * signed) and the offset of the floor halfway along it (16 bits; see FEdge::MidpointHeightOffset). The rest of
+	 * what FEdge holds follows from the node the edge leaves, so a full FEdge is only made when asked for.
+	 */
+	struct FPackedEdge
 	{
-		FNode();
-		explicit FNode(const FAdjacencyListIndex& NewIndex);
-			
-		FAdjacencyListIndex Index;
-		TArray<FEdge> OutEdges;
+		static constexpr int32 DeltaZBits = 10;
+		static constexpr int32 MinDeltaZ = -(1 << (DeltaZBits - 1));
+		static constexpr int32 MaxDeltaZ = (1 << (DeltaZBits - 1)) - 1;
 
-		// serialization/deserialization
-		friend FArchive& operator<<(FArchive& Ar, FNode& Rhs)
+		FPackedEdge() = default;
+
+		/**
+		 * @brief Packs an edge between two nodes.
+		 *
+		 * @return The packed edge, or an empty optional if ToIndex is not a horizontal neighbor of FromIndex within
+		 * MinDeltaZ to MaxDeltaZ grid cells of its height
+		 */
+		static std::optional<FPackedEdge> Pack(const FAdjacencyListIndex& FromIndex, const FAdjacencyListIndex& ToIndex, EMapEdgeType Type, int16 MidpointHeightOffset);
+		static std::optional<FPackedEdge> Pack(const FEdge& Edge);
+
+		FORCEINLINE int32 GetDirection() const { return static_cast<int32>(Bits & 0x7u); }
+		FORCEINLINE EMapEdgeType GetType() const { return static_cast<EMapEdgeType>((Bits >> 3) & 0x7u); }
+		FORCEINLINE int32 GetDeltaZ() const { return static_cast<int32>(Bits << 16) >> (32 - DeltaZBits); }
+		FORCEINLINE int16 GetMidpointHeightOffset() const { return static_cast<int16>(Bits >> 16); }
+
+		FORCEINLINE FAdjacencyListIndex GetTarget(const FAdjacencyListIndex& FromIndex) const
+		{
+			const int32 Direction = GetDirection();
+			return FAdjacencyListIndex(FromIndex.X + DirectionOffsetX[Direction], FromIndex.Y + DirectionOffsetY[Direction], FromIndex.Z + GetDeltaZ());
+		}
+
+		/**
+		 * @return The Euclidean length of the edge in grid cells, as given by Distance between its endpoints
+		 */
+		FORCEINLINE double GetCost() const
+		{
+			const bool bIsDiagonal = IsDiagonalDirection(GetDirection());
+			const int32 DeltaZ = GetDeltaZ();
+			if (DeltaZ == 0) {
+				return bIsDiagonal ? UE_DOUBLE_SQRT_2 : 1.0;
+			}
+			return FMath::Sqrt((bIsDiagonal ? 2.0 : 1.0) + static_cast<double>(DeltaZ * DeltaZ));
+		}
+
+		/**
+		 * @return \c true if both edges lead to the same neighbor, whatever their types
+		 */
+		FORCEINLINE bool HasSameTarget(const FPackedEdge& Other) const
+		{
+			return ((Bits ^ Other.Bits) & TargetMask) == 0;
+		}
+
+		/**
+		 * @return The full edge, for code that wants every detail of it at once (debug drawing, logging)
+		 */
+		FEdge Unpack(const FAdjacencyListIndex& FromIndex) const;
+
+		friend FArchive& operator<<(FArchive& Ar, FPackedEdge& Rhs)
 		{
-			Ar << Rhs.Index.X << Rhs.Index.Y << Rhs.Index.Z << Rhs.OutEdges;
+			Ar << Rhs.Bits;
 			return Ar;
 		}
-		
-		bool operator==(const FNode& Rhs) const;
+
+	private:
+		// the direction and height difference bits
+		static constexpr uint32 TargetMask = 0x7u | (((1u << DeltaZBits) - 1) << 6);
+
+		uint32 Bits = 0;
 	};
-		
+
+	/**
+	 * @brief Read-only view of a node stored in an FNavGridAdjacencyList, pointing into the list's own storage.
+	 *
+	 * Only valid until the list is next modified.
+	 */
+	struct FNodeView
+	{
+		FNodeId Id;
+		FAdjacencyListIndex Index;
+		TConstArrayView<FPackedEdge> OutEdges;
+
+		// nodes with a traversable edge into this node
+		TConstArrayView<FNodeId> InNeighbors;
+
+		uint8 DirectEdgeMask;
+		bool bHasNonDirectEdges;
+	};
+
 	struct FEdge
 	{
 		FEdge();
-		FEdge(const FAdjacencyListIndex& NewInID, const FAdjacencyListIndex& NewOutID, const EMapEdgeType NewType, const FVector& NewDirection);
+		FEdge(const FAdjacencyListIndex& NewInID, const FAdjacencyListIndex& NewOutID, const EMapEdgeType NewType, const FVector& NewDirection, const float MidpointHeight);
 			
 		FAdjacencyListIndex InIndex;
 		FAdjacencyListIndex OutIndex;
 		EMapEdgeType Type;
 		FVector Direction;
 
+		// cost of traversing the edge; derived from its endpoints, so it is recomputed rather than serialized
+		double Cost;
+
+		// height of the floor halfway along the edge, in hundredths of a world unit above the point halfway between
+		// its endpoints' grid heights; found while the grid is built, so paths can be placed on slopes without tracing
+		int16 MidpointHeightOffset;
+
+		/**
+		 * @return The world location of the floor halfway along the edge
+		 */
+		FVector GetMidpoint() const;
+
+		/**
+		 * @return MidpointHeight (a world height) as an offset from the point halfway between two nodes' grid heights
+		 */
+		static int16 GetMidpointHeightOffset(const FAdjacencyListIndex& InIndex, const FAdjacencyListIndex& OutIndex, float MidpointHeight);
+
 		FString ToString() const;
 
 		// serialization/deserialization
 		friend FArchive& operator<<(FArchive& Ar, FEdge& Rhs)
 		{
+			Ar.UsingCustomVersion(FGridNavigatorVersion::GUID);
 			Ar << Rhs.InIndex << Rhs.OutIndex;
+
+			if (Ar.IsLoading()) {
+				Rhs.Cost = Distance(Rhs.InIndex, Rhs.OutIndex);
+			}
 				
 			if (Ar.IsLoading()) {
 				uint8 TypeAsInt;
@@ -62,6 +200,14 @@ namespace NavGrid
 			}
 
 			Ar << Rhs.Direction;
+
+			// edges saved without a midpoint height are placed halfway between their nodes
+			if (Ar.CustomVer(FGridNavigatorVersion::GUID) >= FGridNavigatorVersion::EdgeMidpointHeights) {
+				Ar << Rhs.MidpointHeightOffset;
+			}
+			else if (Ar.IsLoading()) {
+				Rhs.MidpointHeightOffset = 0;
+			}
 				
 			return Ar;
 		}
@@ -1,10 +1,17 @@
 #include "NavGridBuildTask.h"
 
 #include "GridNavigatorConfig.h"
+#include "Async/ParallelFor.h"
 
 DECLARE_LOG_CATEGORY_CLASS(LogNavGridBuildTask, Log, All);
 
-FNavGridBuildTask::FNavGridBuildTask(UWorld* World, ANavigationGridData* Data) : WorldRef(World), DataRef(Data) {}
+FNavGridBuildTask::FNavGridBuildTask(UWorld* World, ANavigationGridData* Data) : WorldRef(World), DataRef(Data)
+{
+	if (Data) {
+		Blocks = Data->GetNavigationBlocks();
+		NumLandmarks = Data->NumLandmarks;
+	}
+}
 
 TStatId FNavGridBuildTask::GetStatId() const 
 {
@@ -27,11 +34,35 @@ void FNavGridBuildTask::DoWork() const
 		return;
 	}
 
-	const auto LevelData = DataRef->GetLevelData();
-	LevelData->Map.Clear();
-	for (auto& [ID, Block] : LevelData->Blocks) {
-		PopulateBlock(*WorldRef, LevelData->Map, Block.Bounds);
+	// the new level is built off to the side, while queries keep reading the published one
+	const TSharedPtr<const FNavGridLevel> PreviousLevel = DataRef->GetLevelData();
+	const TSharedRef<FNavGridLevel> NewLevel = MakeShared<FNavGridLevel>();
+	NewLevel->Blocks = Blocks;
+	TArray<FBox> BlockBounds;
+	BlockBounds.Reserve(Blocks.Num());
+	for (const auto& [ID, Block] : Blocks) {
+		BlockBounds.Add(Block.Bounds);
 	}
+	PopulateBlocks(*WorldRef, NewLevel->Map, BlockBounds);
+	NewLevel->Map.Compact();
+	NewLevel->Landmarks.Build(NewLevel->Map, NumLandmarks);
+
+	// only the clusters and components around nodes that actually changed need rebuilding, so start from the
+	// previous snapshot's
+	TArray<FInt64Vector3> ChangedNodes;
+	if (PreviousLevel) {
+		FNavGridAdjacencyList::GetChangedNodes(PreviousLevel->Map, NewLevel->Map, ChangedNodes);
+		NewLevel->UpdateHierarchy(PreviousLevel->Hierarchy, ChangedNodes);
+		NewLevel->Components = PreviousLevel->Components;
+		NewLevel->Components.Update(PreviousLevel->Map, NewLevel->Map, ChangedNodes);
+	}
+	else {
+		NewLevel->RebuildHierarchy();
+		NewLevel->Components.Build(NewLevel->Map);
+	}
+	NewLevel->FreezeGraph();
+
+	DataRef->PublishLevelData(NewLevel, MoveTemp(ChangedNodes));
 
 	auto Result = OnCompleted.ExecuteIfBound();
 }
@@ -77,173 +108,451 @@ bool IsRoughlyEqual(const float Lhs, const float Rhs, const float Tolerance)
 	return FMath::Abs(Lhs - Rhs) < Tolerance;
 }
 
-void FNavGridBuildTask::PopulateBlock(const UWorld& World, FNavGridAdjacencyList& Map, const FBox& BoundingBox)
+namespace
 {
-	const TArray<TPair<int, int>> Neighbors = {{1, 0}, {1, 1},{0, 1},{-1, 1},{-1, 0},{-1, -1},{0, -1},{1, -1} };
-	
-	const int MinX = FMath::RoundToInt(BoundingBox.Min.X / 100.0);
-	const int MinY = FMath::RoundToInt(BoundingBox.Min.Y / 100.0);
-	const int MinZ = FMath::RoundToInt(BoundingBox.Min.Z / 25.0);
-	const int MaxX = FMath::RoundToInt(BoundingBox.Max.X / 100.0);
-	const int MaxY = FMath::RoundToInt(BoundingBox.Max.Y / 100.0);
-	const int MaxZ = FMath::RoundToInt(BoundingBox.Max.Z / 25.0);
-
-	for (int i = MinX; i <= MaxX; ++i) {
-		for (int j = MinY; j <= MaxY; ++j) {
-			FHitResult HitResult(ForceInit);
-			const bool NodeIJExists = FloorTrace(i, j, MaxZ, MinZ, HitResult, World);
-			
-			if (!NodeIJExists) {
-				continue;
-			}
-
-			FHitResult CeilHitResult(ForceInit);
-			const int HitIndexZ = FMath::RoundToInt(HitResult.Location.Z / 25.0);
-			const bool bShortRoofOverHitPoint = FloorTrace(i, j, HitIndexZ, HitIndexZ + GridNavigatorConfig::MinEmptyLayersForValidNode, CeilHitResult, World);
-
-			// end loop if there's nowhere to stand; also, ignore walls that might be directly
-			// on top of the node (ie. have a near-zero Z component for normal vector)
-			if (bShortRoofOverHitPoint && FMath::Abs(CeilHitResult.Normal.Z) > 0.1) {
-				continue;
-			}
+	// result of tracing down onto one cell of a block
+	struct FFloorSample
+	{
+		FVector Location = FVector::ZeroVector;
+		bool bHasFloor = false;
+
+		// whether there is enough room above the floor to stand, so that a node goes there
+		bool bIsNode = false;
+	};
+
+	// an edge found by a tile, kept until every tile is merged into the map
+	struct FTileEdge
+	{
+		NavGrid::FAdjacencyListIndex FromIndex;
+		NavGrid::FAdjacencyListIndex ToIndex;
+		NavGrid::EMapEdgeType Type;
+		float MidpointHeight;
+	};
+
+	// a node's edge towards a cell that its tile can not see the floor of, kept until every tile has been traced
+	struct FTileSeam
+	{
+		int32 X;
+		int32 Y;
+		int32 Direction;
+	};
+
+	// the cells of a block, inclusive, and the tiles they are split into
+	struct FBuildBlock
+	{
+		FBox Bounds;
+		int32 MinX = 0;
+		int32 MinY = 0;
+		int32 MinZ = 0;
+		int32 MaxX = -1;
+		int32 MaxY = -1;
+		int32 MaxZ = -1;
+
+		int32 FirstTile = 0;
+		int32 NumTilesX = 0;
+
+		FORCEINLINE bool Contains(const int32 X, const int32 Y) const
+		{
+			return X >= MinX && X <= MaxX && Y >= MinY && Y <= MaxY;
+		}
+	};
+
+	/**
+	 * @brief A square of up to BuildTileSize x BuildTileSize cells of a block, traced by a single worker into a
+	 * graph of its own.
+	 */
+	struct FBuildTile
+	{
+		int32 Block = 0;
+		int32 MinX = 0;
+		int32 MinY = 0;
+		int32 MaxX = 0;
+		int32 MaxY = 0;
+
+		// one per cell, row by row
+		TArray<FFloorSample> Samples;
+
+		TArray<NavGrid::FAdjacencyListIndex> Nodes;
+		TArray<FTileEdge> Edges;
+		TArray<FTileSeam> Seams;
+
+		FORCEINLINE bool Contains(const int32 X, const int32 Y) const
+		{
+			return X >= MinX && X <= MaxX && Y >= MinY && Y <= MaxY;
+		}
 
-			if (!Map.HasNode(i, j, HitIndexZ)) {
-				Map.AddNode(i, j, HitIndexZ);
-				UE_LOG(LogNavGridBuildTask, Verbose, TEXT("Added new node to nav grid at indices (%d, %d, %d)"), i, j, HitIndexZ);
-			}
+		FORCEINLINE FFloorSample& GetSample(const int32 X, const int32 Y)
+		{
+			return Samples[(Y - MinY) * (MaxX - MinX + 1) + X - MinX];
+		}
 
-			for (const auto& [NeighborI, NeighborJ] : Neighbors) {
-				FHitResult NeighborHitResult(ForceInit);
-				FIntVector3 NeighborIndex(i + NeighborI, j + NeighborJ, 0);
-				const bool NeighborNodeExists = FloorTrace(NeighborIndex.X, NeighborIndex.Y, MaxZ, MinZ, NeighborHitResult, World);
-			
-				if (!NeighborNodeExists) {
+		FORCEINLINE const FFloorSample& GetSample(const int32 X, const int32 Y) const
+		{
+			return Samples[(Y - MinY) * (MaxX - MinX + 1) + X - MinX];
+		}
+	};
+
+	/**
+	 * @brief Traces the floor of every cell of a tile, and adds a node wherever there is room to stand.
+	 */
+	void SampleTile(const UWorld& World, const FBuildBlock& Block, FBuildTile& Tile)
+	{
+		Tile.Samples.SetNum((Tile.MaxX - Tile.MinX + 1) * (Tile.MaxY - Tile.MinY + 1));
+		for (int32 i = Tile.MinX; i <= Tile.MaxX; ++i) {
+			for (int32 j = Tile.MinY; j <= Tile.MaxY; ++j) {
+				FHitResult HitResult(ForceInit);
+				if (!FloorTrace(i, j, Block.MaxZ, Block.MinZ, HitResult, World)) {
 					continue;
 				}
 
-				// if neighbor is outside bounding box, quit early
-				if (!BoundingBox.IsInside(NeighborHitResult.Location)) {
+				FFloorSample& Sample = Tile.GetSample(i, j);
+				Sample.Location = HitResult.Location;
+				Sample.bHasFloor = true;
+
+				FHitResult CeilHitResult(ForceInit);
+				const int HitIndexZ = FMath::RoundToInt(HitResult.Location.Z / 25.0);
+				const bool bShortRoofOverHitPoint = FloorTrace(i, j, HitIndexZ, HitIndexZ + GridNavigatorConfig::MinEmptyLayersForValidNode, CeilHitResult, World);
+
+				// nowhere to stand; also, ignore walls that might be directly on top of the node (ie. have a
+				// near-zero Z component for normal vector)
+				if (bShortRoofOverHitPoint && FMath::Abs(CeilHitResult.Normal.Z) > 0.1) {
 					continue;
 				}
-	
-				const float NodeHeight = HitResult.Location.Z;
-				const float NeighborHeight = NeighborHitResult.Location.Z;
 
-				FVector ObstrTraceStart = HitResult.Location;
-				FVector ObstrTraceEnd   = NeighborHitResult.Location;
+				Sample.bIsNode = true;
+				Tile.Nodes.Emplace(i, j, HitIndexZ);
+			}
+		}
+	}
 
-				if (NodeHeight < NeighborHeight) {
-					ObstrTraceStart.Z = NeighborHeight;
-				}
-				else if (NeighborHeight < NodeHeight) {
-					ObstrTraceEnd.Z = NodeHeight;
-				}
+	/**
+	 * @brief Traces whether the floor of a node joins up with the floor of a neighboring cell, and how.
+	 */
+	void TraceEdge(const UWorld& World, const FBuildBlock& Block, const int32 i, const int32 j, const FVector& NodeLocation,
+		const int32 NeighborI, const int32 NeighborJ, const FVector& NeighborLocation, FBuildTile& Tile)
+	{
+		const int MaxZ = Block.MaxZ;
+		const int MinZ = Block.MinZ;
 
-				// add a little bit of height to avoid floor collisions
-				ObstrTraceStart.Z += 5.0;
-				ObstrTraceEnd.Z   += 5.0;
+		const float NodeHeight = NodeLocation.Z;
+		const float NeighborHeight = NeighborLocation.Z;
 
-				FHitResult WallHitResult;
-				FCollisionObjectQueryParams ObjectsToTrace = ECC_WorldStatic;
-				
-				const bool IsObstructedLow = World.LineTraceSingleByObjectType(WallHitResult, ObstrTraceStart, ObstrTraceEnd, ObjectsToTrace);
-				if (IsObstructedLow) {
-					continue;
-				}
+		FVector ObstrTraceStart = NodeLocation;
+		FVector ObstrTraceEnd   = NeighborLocation;
 
-				// do a second pass higher up; handles the case where there might be a gap by
-				// character's feet but something to collide with near their head
-				ObstrTraceStart.Z += 100.0;
-				ObstrTraceEnd.Z   += 100.0;
+		if (NodeHeight < NeighborHeight) {
+			ObstrTraceStart.Z = NeighborHeight;
+		}
+		else if (NeighborHeight < NodeHeight) {
+			ObstrTraceEnd.Z = NodeHeight;
+		}
 
-				const bool IsObstructedHigh = World.LineTraceSingleByObjectType(WallHitResult, ObstrTraceStart, ObstrTraceEnd, ObjectsToTrace);
-				if (IsObstructedHigh) {
-					continue;
-				}
+		// add a little bit of height to avoid floor collisions
+		ObstrTraceStart.Z += 5.0;
+		ObstrTraceEnd.Z   += 5.0;
 
-				const float HeightDelta = FMath::Abs(NodeHeight - NeighborHeight);
-				const bool IsDiagonal = (NeighborI != 0) && (NeighborJ != 0); 
-				
-				NavGrid::EMapEdgeType EdgeType = NavGrid::EMapEdgeType::None;
+		FHitResult WallHitResult;
+		FCollisionObjectQueryParams ObjectsToTrace = ECC_WorldStatic;
+		
+		const bool IsObstructedLow = World.LineTraceSingleByObjectType(WallHitResult, ObstrTraceStart, ObstrTraceEnd, ObjectsToTrace);
+		if (IsObstructedLow) {
+			return;
+		}
 
-				if (HeightDelta <= 1.0) {
-					EdgeType = NavGrid::EMapEdgeType::Direct;
-				}
-				else if (HeightDelta <= 51.0 && !IsDiagonal) {
-					EdgeType = NavGrid::EMapEdgeType::Slope;
-				}
-				else if (NodeHeight != NeighborHeight) {
+		// do a second pass higher up; handles the case where there might be a gap by
+		// character's feet but something to collide with near their head
+		ObstrTraceStart.Z += 100.0;
+		ObstrTraceEnd.Z   += 100.0;
+
+		const bool IsObstructedHigh = World.LineTraceSingleByObjectType(WallHitResult, ObstrTraceStart, ObstrTraceEnd, ObjectsToTrace);
+		if (IsObstructedHigh) {
+			return;
+		}
+
+		const float HeightDelta = FMath::Abs(NodeHeight - NeighborHeight);
+		const bool IsDiagonal = (NeighborI != 0) && (NeighborJ != 0); 
+		
+		NavGrid::EMapEdgeType EdgeType = NavGrid::EMapEdgeType::None;
+
+		if (HeightDelta <= 1.0) {
+			EdgeType = NavGrid::EMapEdgeType::Direct;
+		}
+		else if (HeightDelta <= 51.0 && !IsDiagonal) {
+			EdgeType = NavGrid::EMapEdgeType::Slope;
+		}
+		else if (NodeHeight != NeighborHeight) {
+			EdgeType = NavGrid::EMapEdgeType::Cliff;
+		}
+
+		// avoids stepping up/down on the edges of slopes from flat ground
+		if (EdgeType == NavGrid::EMapEdgeType::Slope) {
+			const FIntVector2 NeighborDir(NeighborI, NeighborJ);
+			
+			FHitResult NodeSideSubGridHitResult;
+			bool NodeSideSubGridFloorExists = SubGridFloorTrace(i, j, MaxZ, MinZ, NeighborDir, 0.2, NodeSideSubGridHitResult, World);
+
+			FHitResult NeighborSideSubGridHitResult;
+			bool NeighborSideSubGridFloorExists = SubGridFloorTrace(i, j, MaxZ, MinZ, NeighborDir, 0.8, NeighborSideSubGridHitResult, World);
+
+			if (NodeSideSubGridFloorExists && NeighborSideSubGridFloorExists) {
+				const FVector& NodeSideSubGridLocation     = NodeSideSubGridHitResult.Location;
+				const FVector& NeighborSideSubGridLocation = NeighborSideSubGridHitResult.Location;
+
+				const float NodeSlopeZ     = FMath::Abs(NodeSideSubGridLocation.Z - NodeHeight);
+				const float NeighborSlopeZ = FMath::Abs(NeighborSideSubGridLocation.Z - NeighborHeight);
+
+				const bool SlopesAreEqual = FMath::Abs(NodeSlopeZ - NeighborSlopeZ) < 1.0;
+				const bool SlopesAreFlat = NodeSlopeZ + NeighborSlopeZ < 5.0;
+
+				if (SlopesAreEqual && SlopesAreFlat && NodeHeight != NeighborHeight) {
 					EdgeType = NavGrid::EMapEdgeType::Cliff;
 				}
+			}
+		}
 
-				// avoids stepping up/down on the edges of slopes from flat ground
-				if (EdgeType == NavGrid::EMapEdgeType::Slope) {
-					const FIntVector2 NeighborDir(NeighborI, NeighborJ);
-					
-					FHitResult NodeSideSubGridHitResult;
-					bool NodeSideSubGridFloorExists = SubGridFloorTrace(i, j, MaxZ, MinZ, NeighborDir, 0.2, NodeSideSubGridHitResult, World);
+		// height of the floor halfway along the edge, stored on it so that paths can be placed on the
+		// floor later without tracing again; only slopes can bend between their endpoints
+		float MidpointHeight = (NodeHeight + NeighborHeight) / 2.f;
+
+		// include cases for sloping upwards + downwards so later pathfinding can figure out
+		// what height to put sub-grid points at (ie. tops/bottoms of slopes for path previews)
+		if (EdgeType == NavGrid::EMapEdgeType::Slope) {
+			const FVector2f PointA(i, j);
+			const FVector2f PointB(i + NeighborI, j + NeighborJ);
+			const FVector2f Midpoint = (PointA + PointB) / 2.0;
+
+			FHitResult MidpointHitResult;
+			const bool DidMidpointTraceHit = FloorTrace(Midpoint.X, Midpoint.Y, MaxZ, MinZ, MidpointHitResult, World);
+
+			// tracing between two valid navmesh points should never fail (ie. no gaps)
+			check(DidMidpointTraceHit);
+
+			MidpointHeight = MidpointHitResult.Location.Z;
+			const float AverageHeight = (NodeHeight + NeighborHeight) / 2.f;   
+
+			const bool IsMiddleOfSlope = IsRoughlyEqual(MidpointHeight, AverageHeight, 1.0);
+
+			// if current edge is starting or ending slope, then update its edge type to match that
+			if (!IsMiddleOfSlope) {
+				const bool NodeIsFlatSide     = IsRoughlyEqual(NodeHeight, MidpointHeight, 1.0);
+				const bool NeighborIsFlatSide = !NodeIsFlatSide;
+				const bool NodeIsLowerSide     = NodeHeight < NeighborHeight;
+				const bool NeighborIsLowerSide = !NodeIsLowerSide;
+
+				// truth table time
+				// should probably refactor this to just use an array lookup
+				if      (NodeIsFlatSide     && NodeIsLowerSide)     EdgeType = NavGrid::EMapEdgeType::SlopeBottom;
+				else if (NodeIsFlatSide     && NeighborIsLowerSide) EdgeType = NavGrid::EMapEdgeType::SlopeTop;
+				else if (NeighborIsFlatSide && NodeIsLowerSide)     EdgeType = NavGrid::EMapEdgeType::SlopeTop;
+				else if (NeighborIsFlatSide && NeighborIsLowerSide) EdgeType = NavGrid::EMapEdgeType::SlopeBottom;
+			}
+		}
+
+		const int FromZ = FMath::RoundToInt(NodeHeight / 25.0);
+		const int ToZ   = FMath::RoundToInt(NeighborHeight /  25.0);
 
-					FHitResult NeighborSideSubGridHitResult;
-					bool NeighborSideSubGridFloorExists = SubGridFloorTrace(i, j, MaxZ, MinZ, NeighborDir, 0.8, NeighborSideSubGridHitResult, World);
+		const NavGrid::FAdjacencyListIndex FromIndex(i, j, FromZ);
+		const NavGrid::FAdjacencyListIndex ToIndex(i + NeighborI, j + NeighborJ, ToZ);
+	
+		Tile.Edges.Add({ FromIndex, ToIndex, EdgeType, MidpointHeight });
+	}
 
-					if (NodeSideSubGridFloorExists && NeighborSideSubGridFloorExists) {
-						const FVector& NodeSideSubGridLocation     = NodeSideSubGridHitResult.Location;
-						const FVector& NeighborSideSubGridLocation = NeighborSideSubGridHitResult.Location;
+	/**
+	 * @return The sample of one of a block's cells, from whichever of the block's tiles holds it
+	 */
+	const FFloorSample& GetBlockSample(const FBuildBlock& Block, const TArray<FBuildTile>& Tiles, const int32 X, const int32 Y)
+	{
+		constexpr int32 TileSize = GridNavigatorConfig::BuildTileSize;
+		return Tiles[Block.FirstTile + (Y - Block.MinY) / TileSize * Block.NumTilesX + (X - Block.MinX) / TileSize].GetSample(X, Y);
+	}
 
-						const float NodeSlopeZ     = FMath::Abs(NodeSideSubGridLocation.Z - NodeHeight);
-						const float NeighborSlopeZ = FMath::Abs(NeighborSideSubGridLocation.Z - NeighborHeight);
+	/**
+	 * @brief Traces the edges out of the nodes of a tile towards cells of the same tile, which only need the
+	 * tile's own samples. Every other edge is left as a seam for StitchTile, as are all edges out of cells that
+	 * other blocks share, since only one of the blocks may trace them.
+	 */
+	void TraceTileEdges(const UWorld& World, const TArray<FBuildBlock>& Blocks, FBuildTile& Tile)
+	{
+		const FBuildBlock& Block = Blocks[Tile.Block];
+
+		// blocks share the cells along the boundaries where they touch, and every cell where they overlap
+		TArray<int32> OverlappingBlocks;
+		for (int32 OtherIndex = 0; OtherIndex < Blocks.Num(); ++OtherIndex) {
+			const FBuildBlock& Other = Blocks[OtherIndex];
+			const bool bOverlapsTile = Other.MinX <= Tile.MaxX && Other.MaxX >= Tile.MinX && Other.MinY <= Tile.MaxY && Other.MaxY >= Tile.MinY;
+			if (OtherIndex != Tile.Block && bOverlapsTile) {
+				OverlappingBlocks.Add(OtherIndex);
+			}
+		}
 
-						const bool SlopesAreEqual = FMath::Abs(NodeSlopeZ - NeighborSlopeZ) < 1.0;
-						const bool SlopesAreFlat = NodeSlopeZ + NeighborSlopeZ < 5.0;
+		for (int32 i = Tile.MinX; i <= Tile.MaxX; ++i) {
+			for (int32 j = Tile.MinY; j <= Tile.MaxY; ++j) {
+				const FFloorSample& Sample = Tile.GetSample(i, j);
+				if (!Sample.bIsNode) {
+					continue;
+				}
 
-						if (SlopesAreEqual && SlopesAreFlat && NodeHeight != NeighborHeight) {
-							EdgeType = NavGrid::EMapEdgeType::Cliff;
-						}
+				const bool bIsShared = OverlappingBlocks.ContainsByPredicate([&Blocks, i, j](const int32 OtherIndex)
+				{
+					return Blocks[OtherIndex].Contains(i, j);
+				});
+				for (int32 Direction = 0; Direction < NavGrid::NumDirections; ++Direction) {
+					const int32 NeighborI = NavGrid::DirectionOffsetX[Direction];
+					const int32 NeighborJ = NavGrid::DirectionOffsetY[Direction];
+					if (bIsShared || !Tile.Contains(i + NeighborI, j + NeighborJ)) {
+						Tile.Seams.Add({ i, j, Direction });
+						continue;
 					}
-				}
 
-				// include cases for sloping upwards + downwards so later pathfinding can figure out
-				// what height to put sub-grid points at (ie. tops/bottoms of slopes for path previews)
-				if (EdgeType == NavGrid::EMapEdgeType::Slope) {
-					const FVector2f PointA(i, j);
-					const FVector2f PointB(i + NeighborI, j + NeighborJ);
-					const FVector2f Midpoint = (PointA + PointB) / 2.0;
-
-					FHitResult MidpointHitResult;
-					const bool DidMidpointTraceHit = FloorTrace(Midpoint.X, Midpoint.Y, MaxZ, MinZ, MidpointHitResult, World);
-
-					// tracing between two valid navmesh points should never fail (ie. no gaps)
-					check(DidMidpointTraceHit);
-
-					const float MidpointHeight = MidpointHitResult.Location.Z;
-					const float AverageHeight = (NodeHeight + NeighborHeight) / 2.f;   
-
-					const bool IsMiddleOfSlope = IsRoughlyEqual(MidpointHeight, AverageHeight, 1.0);
-
-					// if current edge is starting or ending slope, then update its edge type to match that
-					if (!IsMiddleOfSlope) {
-						const bool NodeIsFlatSide     = IsRoughlyEqual(NodeHeight, MidpointHeight, 1.0);
-						const bool NeighborIsFlatSide = !NodeIsFlatSide;
-						const bool NodeIsLowerSide     = NodeHeight < NeighborHeight;
-						const bool NeighborIsLowerSide = !NodeIsLowerSide;
-
-						// truth table time
-						// should probably refactor this to just use an array lookup
-						if      (NodeIsFlatSide     && NodeIsLowerSide)     EdgeType = NavGrid::EMapEdgeType::SlopeBottom;
-						else if (NodeIsFlatSide     && NeighborIsLowerSide) EdgeType = NavGrid::EMapEdgeType::SlopeTop;
-						else if (NeighborIsFlatSide && NodeIsLowerSide)     EdgeType = NavGrid::EMapEdgeType::SlopeTop;
-						else if (NeighborIsFlatSide && NeighborIsLowerSide) EdgeType = NavGrid::EMapEdgeType::SlopeBottom;
+					// a neighbor without floor inside the block may still have floor inside another one
+					const FFloorSample& NeighborSample = Tile.GetSample(i + NeighborI, j + NeighborJ);
+					if (!NeighborSample.bHasFloor || !Block.Bounds.IsInside(NeighborSample.Location)) {
+						Tile.Seams.Add({ i, j, Direction });
+						continue;
 					}
+
+					TraceEdge(World, Block, i, j, Sample.Location, NeighborI, NeighborJ, NeighborSample.Location, Tile);
 				}
+			}
+		}
+	}
 
-				const int FromZ = FMath::RoundToInt(NodeHeight / 25.0);
-				const int ToZ   = FMath::RoundToInt(NeighborHeight /  25.0);
+	/**
+	 * @return \c true if a block has floor inside its bounds in one of its cells
+	 */
+	bool HasFloorInside(const FBuildBlock& Block, const TArray<FBuildTile>& Tiles, const int32 X, const int32 Y)
+	{
+		if (!Block.Contains(X, Y)) {
+			return false;
+		}
+		const FFloorSample& Sample = GetBlockSample(Block, Tiles, X, Y);
+		return Sample.bHasFloor && Block.Bounds.IsInside(Sample.Location);
+	}
 
-				const NavGrid::FAdjacencyListIndex FromIndex(i, j, FromZ);
-				const NavGrid::FAdjacencyListIndex ToIndex(i + NeighborI, j + NeighborJ, ToZ);
-			
-				Map.CreateEdge(FromIndex, ToIndex, EdgeType);
+	/**
+	 * @brief Finds the floor an edge across a seam leads to: in another tile of the node's own block if the block
+	 * has floor there, or else in the first other block that does.
+	 *
+	 * Blocks that touch share the cells along their boundary, so a node can belong to several of them, and each
+	 * edge out of it must only be traced by one. That is the first of them with floor in the neighboring cell,
+	 * which reaches it without crossing into another block, or else the first of them that holds the node.
+	 *
+	 * @return The sample of the floor, or nullptr if the edge is traced by another block, or not at all
+	 */
+	const FFloorSample* FindSeamSample(const TArray<FBuildBlock>& Blocks, const TArray<FBuildTile>& Tiles, const int32 BlockIndex,
+		const int32 i, const int32 j, const FFloorSample& NodeSample, const int32 X, const int32 Y)
+	{
+		const bool bHasFloor = HasFloorInside(Blocks[BlockIndex], Tiles, X, Y);
+		const FFloorSample* NeighborSample = bHasFloor ? &GetBlockSample(Blocks[BlockIndex], Tiles, X, Y) : nullptr;
+		const int32 NodeZ = FMath::RoundToInt(NodeSample.Location.Z / 25.0);
+		for (int32 OtherIndex = 0; OtherIndex < Blocks.Num(); ++OtherIndex) {
+			const FBuildBlock& Other = Blocks[OtherIndex];
+			if (OtherIndex == BlockIndex) {
+				continue;
+			}
+
+			const bool bOtherHasFloor = HasFloorInside(Other, Tiles, X, Y);
+			if (Other.Contains(i, j)) {
+				const FFloorSample& SharedSample = GetBlockSample(Other, Tiles, i, j);
+				const bool bSharesNode = SharedSample.bIsNode && FMath::RoundToInt(SharedSample.Location.Z / 25.0) == NodeZ;
+				const bool bOtherTracesFirst = bHasFloor
+					? bOtherHasFloor && OtherIndex < BlockIndex
+					: bOtherHasFloor || OtherIndex < BlockIndex;
+				if (bSharesNode && bOtherTracesFirst) {
+					return nullptr;
+				}
+			}
+			if (bOtherHasFloor && !NeighborSample) {
+				NeighborSample = &GetBlockSample(Other, Tiles, X, Y);
+			}
+		}
+		return NeighborSample;
+	}
+
+	/**
+	 * @brief Traces the edges a tile left as seams, now that every tile of every block has been sampled; this joins
+	 * the tile to the tiles next to it, whether they belong to the same block or to a neighboring one.
+	 */
+	void StitchTile(const UWorld& World, const TArray<FBuildBlock>& Blocks, const TArray<FBuildTile>& Tiles, FBuildTile& Tile)
+	{
+		for (const auto& [i, j, Direction] : Tile.Seams) {
+			const int32 NeighborI = NavGrid::DirectionOffsetX[Direction];
+			const int32 NeighborJ = NavGrid::DirectionOffsetY[Direction];
+			const FFloorSample& Sample = Tile.GetSample(i, j);
+			const FFloorSample* NeighborSample = FindSeamSample(Blocks, Tiles, Tile.Block, i, j, Sample, i + NeighborI, j + NeighborJ);
+			if (NeighborSample) {
+				TraceEdge(World, Blocks[Tile.Block], i, j, Sample.Location, NeighborI, NeighborJ, NeighborSample->Location, Tile);
 			}
 		}
+		Tile.Seams.Empty();
 	}
 }
+
+void FNavGridBuildTask::PopulateBlocks(const UWorld& World, FNavGridAdjacencyList& Map, const TConstArrayView<FBox> BlockBounds)
+{
+	constexpr int32 TileSize = GridNavigatorConfig::BuildTileSize;
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FBuildBlock> Blocks;
+	TArray<FBuildTile> Tiles;
+	for (const FBox& BoundingBox : BlockBounds) {
+		FBuildBlock& Block = Blocks.Emplace_GetRef();
+		Block.Bounds = BoundingBox;
+		Block.MinX = FMath::RoundToInt(BoundingBox.Min.X / 100.0);
+		Block.MinY = FMath::RoundToInt(BoundingBox.Min.Y / 100.0);
+		Block.MinZ = FMath::RoundToInt(BoundingBox.Min.Z / 25.0);
+		Block.MaxX = FMath::RoundToInt(BoundingBox.Max.X / 100.0);
+		Block.MaxY = FMath::RoundToInt(BoundingBox.Max.Y / 100.0);
+		Block.MaxZ = FMath::RoundToInt(BoundingBox.Max.Z / 25.0);
+		Block.FirstTile = Tiles.Num();
+		if (Block.MinX > Block.MaxX || Block.MinY > Block.MaxY) {
+			continue;
+		}
+
+		Block.NumTilesX = (Block.MaxX - Block.MinX) / TileSize + 1;
+		const int32 NumTilesY = (Block.MaxY - Block.MinY) / TileSize + 1;
+		for (int32 TileY = 0; TileY < NumTilesY; ++TileY) {
+			for (int32 TileX = 0; TileX < Block.NumTilesX; ++TileX) {
+				FBuildTile& Tile = Tiles.Emplace_GetRef();
+				Tile.Block = Blocks.Num() - 1;
+				Tile.MinX = Block.MinX + TileX * TileSize;
+				Tile.MinY = Block.MinY + TileY * TileSize;
+				Tile.MaxX = FMath::Min(Tile.MinX + TileSize - 1, Block.MaxX);
+				Tile.MaxY = FMath::Min(Tile.MinY + TileSize - 1, Block.MaxY);
+			}
+		}
+	}
+
+	// traces only read the world, so every tile is traced on its own worker, along with the edges inside it
+	ParallelFor(Tiles.Num(), [&](const int32 TileIndex)
+	{
+		FBuildTile& Tile = Tiles[TileIndex];
+		SampleTile(World, Blocks[Tile.Block], Tile);
+		TraceTileEdges(World, Blocks, Tile);
+	});
+
+	// an edge across a seam needs the floor on the far side, which is only known once the tile there is traced;
+	// that tile may belong to another block, so edges between neighboring blocks are stitched here as well
+	ParallelFor(Tiles.Num(), [&](const int32 TileIndex)
+	{
+		StitchTile(World, Blocks, Tiles, Tiles[TileIndex]);
+	});
+
+	// merged in a fixed order, so that the map comes out the same however the tiles were scheduled
+	int32 NumEdges = 0;
+	for (const FBuildTile& Tile : Tiles) {
+		for (const NavGrid::FAdjacencyListIndex& Index : Tile.Nodes) {
+			if (!Map.HasNode(Index)) {
+				Map.AddNode(Index);
+				UE_LOG(LogNavGridBuildTask, Verbose, TEXT("Added new node to nav grid at indices (%lld, %lld, %lld)"), Index.X, Index.Y, Index.Z);
+			}
+		}
+		for (const FTileEdge& Edge : Tile.Edges) {
+			Map.CreateEdge(Edge.FromIndex, Edge.ToIndex, Edge.Type, Edge.MidpointHeight);
+		}
+		NumEdges += Tile.Edges.Num();
+	}
+
+	UE_LOG(LogNavGridBuildTask, Log, TEXT("Traced %d blocks as %d tiles into %d nodes and %d edges in %.1f ms"),
+		Blocks.Num(), Tiles.Num(), Map.GetNumNodes(), NumEdges, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
@@ -3,6 +3,13 @@
 
 DECLARE_DELEGATE(FNavGridBuildTaskDelegate)
 
+/**
+ * @brief Builds a new snapshot of a navigation data's level on a worker thread, then publishes it.
+ *
+ * The blocks to build and the build settings are copied when the task is created, on the game thread, so the
+ * task never reads anything the game thread may be editing, and queries keep running on the previous snapshot
+ * until the new one is published.
+ */
 class FNavGridBuildTask : public FNonAbandonableTask
 {
 public:
@@ -12,11 +19,27 @@ public:
 	FORCEINLINE bool CanAbandon() const;
 
 	void DoWork() const;
-	static void PopulateBlock(const UWorld& World, FNavGridAdjacencyList& Map, const FBox& BoundingBox);
+
+	/**
+	 * @brief Traces the grid for a set of navigation blocks into a map.
+	 *
+	 * Each block is split into tiles of BuildTileSize x BuildTileSize cells, which are traced in parallel into
+	 * graphs of their own. Once every tile is traced, a second parallel pass stitches neighboring tiles together
+	 * by tracing the edges across their seams, including those between tiles of blocks that touch, and the tiles
+	 * are then merged into the map in a fixed order.
+	 *
+	 * @param World World to trace against; only read from, on several worker threads at once
+	 * @param Map Map to add the nodes and edges to; the edges are left waiting to be compacted
+	 * @param BlockBounds World space bounds of each block to trace
+	 */
+	static void PopulateBlocks(const UWorld& World, FNavGridAdjacencyList& Map, TConstArrayView<FBox> BlockBounds);
 
 	FNavGridBuildTaskDelegate OnCompleted;
 
 private:
 	TObjectPtr<UWorld> WorldRef;
 	TObjectPtr<ANavigationGridData> DataRef;
+
+	TMap<uint32, FNavGridBlock> Blocks;
+	int32 NumLandmarks = 0;
 };
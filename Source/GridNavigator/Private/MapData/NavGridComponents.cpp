@@ -0,0 +1,99 @@
+#include "NavGridComponents.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogNavGridComponents, Log, All)
+
+using NavGrid::FAdjacencyListIndex;
+
+void FNavGridComponents::Build(const FNavGridAdjacencyList& Map)
+{
+	Clear();
+
+	TSet<FAdjacencyListIndex> Visited;
+	TSet<uint32> ReplacedLabels;
+	Map.ForEachNode([&](const NavGrid::FNodeView& Node)
+	{
+		if (!Visited.Contains(Node.Index)) {
+			Flood(Map, Node.Index, Visited, ReplacedLabels);
+			++NumComponents;
+		}
+	});
+
+	UE_LOG(LogNavGridComponents, Log, TEXT("Labeled %d connected components over %d nodes"), NumComponents, Labels.Num());
+}
+
+void FNavGridComponents::Update(const FNavGridAdjacencyList& Before, const FNavGridAdjacencyList& After, const TConstArrayView<FAdjacencyListIndex> ChangedNodes)
+{
+	// every node whose edges changed on either end gets flooded again; any other node is only relabeled if the
+	// flood reaches it, since a component without any of these nodes is exactly as it was before the edit
+	TArray<FAdjacencyListIndex> Seeds;
+	TSet<uint32> ReplacedLabels;
+	const auto AddSeed = [&Seeds](const FAdjacencyListIndex& Neighbor, double)
+	{
+		Seeds.Add(Neighbor);
+	};
+
+	for (const FAdjacencyListIndex& Changed : ChangedNodes) {
+		if (After.HasNode(Changed)) {
+			Seeds.Add(Changed);
+		}
+		else if (const uint32* Label = Labels.Find(Changed)) {
+			ReplacedLabels.Add(*Label);
+			Labels.Remove(Changed);
+		}
+		Before.ForEachReachableNeighbor(Changed, AddSeed);
+		After.ForEachReachableNeighbor(Changed, AddSeed);
+	}
+
+	TSet<FAdjacencyListIndex> Visited;
+	int32 NumFlooded = 0;
+	for (const FAdjacencyListIndex& Seed : Seeds) {
+		if (After.HasNode(Seed) && !Visited.Contains(Seed)) {
+			Flood(After, Seed, Visited, ReplacedLabels);
+			++NumFlooded;
+		}
+	}
+
+	// a component that was flooded at all was flooded completely, so each replaced label is a component gone
+	NumComponents += NumFlooded - ReplacedLabels.Num();
+
+	UE_LOG(LogNavGridComponents, Verbose, TEXT("Relabeled %d nodes into %d components from %d changed nodes; %d components in total"),
+		Visited.Num(), NumFlooded, ChangedNodes.Num(), NumComponents);
+}
+
+void FNavGridComponents::Clear()
+{
+	Labels.Empty();
+	NumComponents = 0;
+}
+
+void FNavGridComponents::Flood(const FNavGridAdjacencyList& Map, const FAdjacencyListIndex& Seed, TSet<FAdjacencyListIndex>& Visited, TSet<uint32>& OutReplacedLabels)
+{
+	const uint32 Label = NextLabel++;
+
+	TArray<FAdjacencyListIndex> Stack;
+	Stack.Add(Seed);
+	Visited.Add(Seed);
+
+	const auto Visit = [&Stack, &Visited](const FAdjacencyListIndex& Neighbor, double)
+	{
+		bool bWasVisited = false;
+		Visited.Add(Neighbor, &bWasVisited);
+		if (!bWasVisited) {
+			Stack.Add(Neighbor);
+		}
+	};
+
+	while (!Stack.IsEmpty()) {
+		const FAdjacencyListIndex Current = Stack.Pop(false);
+
+		uint32& CurrentLabel = Labels.FindOrAdd(Current, InvalidComponent);
+		if (CurrentLabel != InvalidComponent) {
+			OutReplacedLabels.Add(CurrentLabel);
+		}
+		CurrentLabel = Label;
+
+		// edge direction is ignored, so a node joins the component whether it leads into it or out of it
+		Map.ForEachReachableNeighbor(Current, Visit);
+		Map.ForEachReachingNeighbor(Current, Visit);
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "NavGridAdjacencyList.h"
+
+/**
+ * @class FNavGridComponents
+ * @brief Labels every grid node with the connected component it belongs to, so that queries between nodes that
+ * cannot possibly reach each other (eg. onto a roof with no way up) are rejected without searching.
+ *
+ * Components are found over traversable edges with their direction ignored. Nodes with different labels never
+ * have a path between them; nodes with the same label usually do, but a one-way edge can still leave one of them
+ * unable to reach the other, in which case a search is needed to find out.
+ */
+class FNavGridComponents
+{
+public:
+	// label of nodes that are not part of the map
+	static constexpr uint32 InvalidComponent = 0;
+
+	/**
+	 * @brief Labels every node of a map from scratch, replacing any previous labels.
+	 */
+	void Build(const FNavGridAdjacencyList& Map);
+
+	/**
+	 * @brief Brings the labels up to date with an edit to the map, relabeling only the components the edit touched.
+	 *
+	 * Components made up entirely of nodes whose edges did not change keep their labels; every other node is
+	 * flooded again from the changed nodes and the neighbors they gained or lost.
+	 *
+	 * @param Before The map the current labels were built from
+	 * @param After The map as it is after the edit
+	 * @param ChangedNodes The nodes whose traversable edges differ between the two maps (see FNavGridAdjacencyList::GetChangedNodes)
+	 */
+	void Update(const FNavGridAdjacencyList& Before, const FNavGridAdjacencyList& After, TConstArrayView<NavGrid::FAdjacencyListIndex> ChangedNodes);
+
+	void Clear();
+
+	/**
+	 * @return The label of the component a node belongs to, or InvalidComponent if the node is not in the map
+	 */
+	FORCEINLINE uint32 GetComponent(const NavGrid::FAdjacencyListIndex& Index) const
+	{
+		const uint32* Label = Labels.Find(Index);
+		return Label ? *Label : InvalidComponent;
+	}
+
+	/**
+	 * @return \c true if both nodes are in the map and in the same component; \c false if there is no path between them
+	 */
+	FORCEINLINE bool AreConnected(const NavGrid::FAdjacencyListIndex& A, const NavGrid::FAdjacencyListIndex& B) const
+	{
+		const uint32 Component = GetComponent(A);
+		return Component != InvalidComponent && Component == GetComponent(B);
+	}
+
+	FORCEINLINE int32 GetNumComponents() const { return NumComponents; }
+	FORCEINLINE bool IsEmpty() const { return Labels.IsEmpty(); }
+
+private:
+	/**
+	 * @brief Gives a new label to every node connected to Seed that has not been given one by this pass yet.
+	 *
+	 * @param Visited Nodes already labeled by this pass; receives the nodes labeled by this call
+	 * @param OutReplacedLabels Receives the labels the flooded nodes had before
+	 */
+	void Flood(const FNavGridAdjacencyList& Map, const NavGrid::FAdjacencyListIndex& Seed, TSet<NavGrid::FAdjacencyListIndex>& Visited, TSet<uint32>& OutReplacedLabels);
+
+	TMap<NavGrid::FAdjacencyListIndex, uint32> Labels;
+
+	// labels are never reused, so a component that is relabeled can never be mistaken for the one it replaced
+	uint32 NextLabel = InvalidComponent + 1;
+	int32 NumComponents = 0;
+};
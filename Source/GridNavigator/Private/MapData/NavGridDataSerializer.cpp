@@ -1,5 +1,8 @@
 #include "NavGridDataSerializer.h"
 
+#include "GridNavigatorVersion.h"
+#include "Navigation/NavGridPathCache.h"
+
 DECLARE_LOG_CATEGORY_CLASS(LogNavGridDataSerializer, Log, All)
 
 void operator<<(FArchive& Archive, FNavGridAdjacencyList& Data)
@@ -15,8 +18,21 @@ void operator<<(FArchive& Archive, FNavGridBlock& Data)
 
 void operator<<(FArchive& Archive, FNavGridLevel& Data)
 {
+	Archive.UsingCustomVersion(FGridNavigatorVersion::GUID);
+
 	Archive << Data.Blocks;
 	Archive << Data.Map;
+
+	// data saved before landmark tables were stored ends with the map, and loads without any landmarks
+	if (Archive.CustomVer(FGridNavigatorVersion::GUID) >= FGridNavigatorVersion::LandmarkTables) {
+		Data.Landmarks.Serialize(Archive);
+	}
+
+	if (Archive.IsLoading()) {
+		Data.RebuildHierarchy();
+		Data.Components.Build(Data.Map);
+		Data.FreezeGraph();
+	}
 }
 
 void FNavGridDataSerializer::Serialize(FArchive& Ar, ANavigationGridData* NavData)
@@ -25,10 +41,38 @@ void FNavGridDataSerializer::Serialize(FArchive& Ar, ANavigationGridData* NavDat
 		UE_LOG(LogNavGridDataSerializer, Error, TEXT("Tried to serialize a null NavigationGridData reference"));
 		return;
 	}
-	if (!NavData->LevelData) {
+	Ar.UsingCustomVersion(FGridNavigatorVersion::GUID);
+
+	TSharedPtr<FNavGridLevel> Level;
+	{
+		FScopeLock ScopeLock(&NavData->LevelDataLock);
+		Level = NavData->LevelData;
+	}
+	if (!Level) {
 		UE_LOG(LogNavGridDataSerializer, Error, TEXT("Tried to serialize a NavigationGridData object with no LevelData"));
 		return;
 	}
 
-	Ar << *NavData->LevelData;
+	if (!Ar.IsLoading()) {
+		// saving only reads the snapshot, so the published one can be written out while queries run on it
+		Ar << *Level;
+		return;
+	}
+
+	// loading fills in a new snapshot, which replaces the current one like a finished build would
+	const TSharedRef<FNavGridLevel> LoadedLevel = MakeShared<FNavGridLevel>();
+	Ar << *LoadedLevel;
+
+	// loaded without landmark tables, from older data or from tables that did not match the map, so compute them
+	// the way a build would
+	if (LoadedLevel->Landmarks.IsEmpty() && NavData->NumLandmarks > 0) {
+		LoadedLevel->Landmarks.Build(LoadedLevel->Map, NavData->NumLandmarks);
+		LoadedLevel->Landmarks.ReorderFor(LoadedLevel->Graph);
+	}
+
+	NavData->Blocks = LoadedLevel->Blocks;
+
+	TArray<FInt64Vector3> ChangedNodes;
+	FNavGridAdjacencyList::GetChangedNodes(Level->Map, LoadedLevel->Map, ChangedNodes);
+	NavData->PublishLevelData(LoadedLevel, MoveTemp(ChangedNodes));
 }
@@ -0,0 +1,291 @@
+#include "NavGridFrozenGraph.h"
+
+#include <cmath>
+
+#include "GridNavigatorStats.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogNavGridFrozenGraph, Log, All)
+
+using NavGrid::FAdjacencyListIndex;
+
+namespace
+{
+	/**
+	 * @return The low 32 bits of Value, moved to the even bits of the result
+	 */
+	FORCEINLINE uint64 SpreadBits(uint64 Value)
+	{
+		Value &= 0x00000000FFFFFFFFull;
+		Value = (Value | (Value << 16)) & 0x0000FFFF0000FFFFull;
+		Value = (Value | (Value << 8)) & 0x00FF00FF00FF00FFull;
+		Value = (Value | (Value << 4)) & 0x0F0F0F0F0F0F0F0Full;
+		Value = (Value | (Value << 2)) & 0x3333333333333333ull;
+		Value = (Value | (Value << 1)) & 0x5555555555555555ull;
+		return Value;
+	}
+
+	struct FFrozenNode
+	{
+		uint64 Key;
+		FIntVector3 Location;
+		NavGrid::FNodeView View;
+	};
+}
+
+void FNavGridFrozenGraph::Build(const FNavGridAdjacencyList& Map)
+{
+	checkf(!Map.HasPendingEdges(), TEXT("The adjacency list must be compacted before it is frozen"));
+
+	Clear();
+	Generation = NextGeneration.fetch_add(1, std::memory_order_relaxed);
+
+	TArray<FFrozenNode> Nodes;
+	Nodes.Reserve(Map.GetNumNodes());
+	OriginX = TNumericLimits<int64>::Max();
+	OriginY = TNumericLimits<int64>::Max();
+	Map.ForEachNode([&](const NavGrid::FNodeView& Node)
+	{
+		Nodes.Add({ 0, FIntVector3(), Node });
+		OriginX = FMath::Min(OriginX, Node.Index.X);
+		OriginY = FMath::Min(OriginY, Node.Index.Y);
+	});
+	if (Nodes.IsEmpty()) {
+		OriginX = 0;
+		OriginY = 0;
+		return;
+	}
+
+	for (FFrozenNode& Node : Nodes) {
+		Node.Location = FIntVector3(Node.View.Index.X - OriginX, Node.View.Index.Y - OriginY, Node.View.Index.Z);
+		Node.Key = GetCurveKey(Node.Location);
+		SizeX = FMath::Max(SizeX, Node.Location.X + 1);
+		SizeY = FMath::Max(SizeY, Node.Location.Y + 1);
+	}
+	Nodes.Sort([](const FFrozenNode& A, const FFrozenNode& B)
+	{
+		return IsBefore(A.Key, A.Location.Z, B.Key, B.Location.Z);
+	});
+
+	TMap<NavGrid::FNodeId, uint32> NodeNumbers;
+	NodeNumbers.Reserve(Nodes.Num());
+	Locations.Reserve(Nodes.Num());
+	for (const FFrozenNode& Node : Nodes) {
+		NodeNumbers.Add(Node.View.Id, Locations.Add(Node.Location));
+	}
+
+	EdgeOffsets.Reserve(Nodes.Num() + 1);
+	for (const FFrozenNode& Node : Nodes) {
+		EdgeOffsets.Add(Targets.Num());
+		for (const NavGrid::FPackedEdge Edge : Node.View.OutEdges) {
+			if (!NavGrid::IsTraversableEdgeType(Edge.GetType())) {
+				continue;
+			}
+
+			const double EdgeCost = Edge.GetCost();
+			float Cost = static_cast<float>(EdgeCost);
+			if (Cost < EdgeCost) {
+				Cost = std::nextafter(Cost, TNumericLimits<float>::Max());
+			}
+			Targets.Add(NodeNumbers.FindChecked(Map.FindNodeId(Edge.GetTarget(Node.View.Index))));
+			Costs.Add(Cost);
+		}
+	}
+	EdgeOffsets.Add(Targets.Num());
+
+	// group the same edges by target: count the edges into each node, then place each edge after those before it
+	InEdgeOffsets.Init(0, Locations.Num() + 1);
+	for (const uint32 Target : Targets) {
+		++InEdgeOffsets[Target + 1];
+	}
+	for (int32 Node = 0; Node < Locations.Num(); ++Node) {
+		InEdgeOffsets[Node + 1] += InEdgeOffsets[Node];
+	}
+
+	TArray<int32> NextInEdge(InEdgeOffsets.GetData(), Locations.Num());
+	Sources.SetNumUninitialized(Targets.Num());
+	InCosts.SetNumUninitialized(Targets.Num());
+	for (int32 Node = 0; Node < Locations.Num(); ++Node) {
+		for (int32 Edge = EdgeOffsets[Node]; Edge < EdgeOffsets[Node + 1]; ++Edge) {
+			const int32 InEdge = NextInEdge[Targets[Edge]]++;
+			Sources[InEdge] = static_cast<uint32>(Node);
+			InCosts[InEdge] = Costs[Edge];
+		}
+	}
+
+	// the graph is never added to, so give back whatever the arrays grew by while it was being filled
+	Targets.Shrink();
+	Costs.Shrink();
+
+	SET_MEMORY_STAT(STAT_GridNavigator_FrozenGraphMemory, GetAllocatedSize());
+	UE_LOG(LogNavGridFrozenGraph, Log, TEXT("Froze %d nodes and %d edges, using %.1f KiB (%llu bytes per node)"),
+		Locations.Num(), Targets.Num(), GetAllocatedSize() / 1024.0, static_cast<uint64>(GetAllocatedSize() / Locations.Num()));
+}
+
+void FNavGridFrozenGraph::Clear()
+{
+	Locations.Empty();
+	EdgeOffsets.Empty();
+	Targets.Empty();
+	Costs.Empty();
+	InEdgeOffsets.Empty();
+	Sources.Empty();
+	InCosts.Empty();
+	OriginX = 0;
+	OriginY = 0;
+	SizeX = 0;
+	SizeY = 0;
+	Generation = 0;
+	SET_MEMORY_STAT(STAT_GridNavigator_FrozenGraphMemory, 0);
+}
+
+uint32 FNavGridFrozenGraph::FindNode(const FAdjacencyListIndex& Index) const
+{
+	const int64 X = Index.X - OriginX;
+	const int64 Y = Index.Y - OriginY;
+	if (Locations.IsEmpty() || X < 0 || Y < 0 || X > MAX_int32 || Y > MAX_int32 || Index.Z < MIN_int32 || Index.Z > MAX_int32) {
+		return InvalidNode;
+	}
+
+	const FIntVector3 Location(static_cast<int32>(X), static_cast<int32>(Y), static_cast<int32>(Index.Z));
+	const int32 Node = FindFirstNodeFrom(GetCurveKey(Location), Location.Z);
+	return Node < Locations.Num() && Locations[Node] == Location ? static_cast<uint32>(Node) : InvalidNode;
+}
+
+double FNavGridFrozenGraph::GetEdgeCost(const uint32 From, const uint32 To) const
+{
+	if (!HasNode(From)) {
+		return -1.0;
+	}
+
+	const int32 EdgesEnd = EdgeOffsets[From + 1];
+	for (int32 Edge = EdgeOffsets[From]; Edge < EdgesEnd; ++Edge) {
+		if (Targets[Edge] == To) {
+			return static_cast<double>(Costs[Edge]);
+		}
+	}
+	return -1.0;
+}
+
+uint32 FNavGridFrozenGraph::FindNearestNode(const FVector& Location, const FVector& Extent) const
+{
+	return FindNearestNode(Location, FBox(Location - Extent, Location + Extent), TNumericLimits<double>::Max());
+}
+
+uint32 FNavGridFrozenGraph::FindNearestNode(const FVector& Location, const FBox& Bounds) const
+{
+	return FindNearestNode(Location, Bounds, TNumericLimits<double>::Max());
+}
+
+uint32 FNavGridFrozenGraph::FindNearestNode(const FVector& Location, const double Radius) const
+{
+	return FindNearestNode(Location, FBox(Location - FVector(Radius), Location + FVector(Radius)), Radius * Radius);
+}
+
+uint32 FNavGridFrozenGraph::FindNearestNode(const FVector& Location, const FBox& Bounds, const double MaxDistanceSquared) const
+{
+	constexpr double GridSizeX = GridNavigatorConfig::GridSizeX;
+	constexpr double GridSizeY = GridNavigatorConfig::GridSizeY;
+	constexpr double GridSizeZ = GridNavigatorConfig::GridSizeZ;
+
+	// the cells inside the bounds, relative to the origin and clamped to the graph, so that a huge box costs no
+	// more than one covering the whole graph
+	const double MinX = FMath::Max(std::ceil(Bounds.Min.X / GridSizeX) - OriginX, 0.0);
+	const double MinY = FMath::Max(std::ceil(Bounds.Min.Y / GridSizeY) - OriginY, 0.0);
+	const double MaxX = FMath::Min(std::floor(Bounds.Max.X / GridSizeX) - OriginX, SizeX - 1.0);
+	const double MaxY = FMath::Min(std::floor(Bounds.Max.Y / GridSizeY) - OriginY, SizeY - 1.0);
+	const double MinZ = std::ceil(Bounds.Min.Z / GridSizeZ);
+	const double MaxZ = std::floor(Bounds.Max.Z / GridSizeZ);
+	if (IsEmpty() || MinX > MaxX || MinY > MaxY || MinZ > MaxZ) {
+		return InvalidNode;
+	}
+
+	const int32 CellMinX = static_cast<int32>(MinX);
+	const int32 CellMinY = static_cast<int32>(MinY);
+	const int32 CellMaxX = static_cast<int32>(MaxX);
+	const int32 CellMaxY = static_cast<int32>(MaxY);
+
+	// distance from the location to the part of a range of cells inside the bounds, along one axis
+	const auto GetAxisDistance = [](const double Coordinate, const int64 Origin, const double GridSize, const int32 First, const int32 Last)
+	{
+		const double Low = (Origin + First) * GridSize;
+		const double High = (Origin + Last) * GridSize;
+		return Coordinate < Low ? Low - Coordinate : Coordinate > High ? Coordinate - High : 0.0;
+	};
+
+	TArray<TPair<double, FIntPoint>> Blocks;
+	for (int32 BlockY = CellMinY / ProjectionBlockSize; BlockY <= CellMaxY / ProjectionBlockSize; ++BlockY) {
+		const int32 FirstY = FMath::Max(BlockY * ProjectionBlockSize, CellMinY);
+		const int32 LastY = FMath::Min(BlockY * ProjectionBlockSize + ProjectionBlockSize - 1, CellMaxY);
+		const double DistanceY = GetAxisDistance(Location.Y, OriginY, GridSizeY, FirstY, LastY);
+
+		for (int32 BlockX = CellMinX / ProjectionBlockSize; BlockX <= CellMaxX / ProjectionBlockSize; ++BlockX) {
+			const int32 FirstX = FMath::Max(BlockX * ProjectionBlockSize, CellMinX);
+			const int32 LastX = FMath::Min(BlockX * ProjectionBlockSize + ProjectionBlockSize - 1, CellMaxX);
+			const double DistanceX = GetAxisDistance(Location.X, OriginX, GridSizeX, FirstX, LastX);
+			Blocks.Emplace(DistanceX * DistanceX + DistanceY * DistanceY, FIntPoint(BlockX, BlockY));
+		}
+	}
+	Blocks.Sort([](const TPair<double, FIntPoint>& A, const TPair<double, FIntPoint>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	constexpr uint64 KeysPerBlock = static_cast<uint64>(ProjectionBlockSize) * ProjectionBlockSize;
+
+	uint32 NearestNode = InvalidNode;
+	double NearestDistanceSquared = MaxDistanceSquared;
+	for (const auto& [BlockDistanceSquared, Block] : Blocks) {
+		if (BlockDistanceSquared > NearestDistanceSquared) {
+			break;
+		}
+
+		const uint64 FirstKey = GetCurveKey(FIntVector3(Block.X * ProjectionBlockSize, Block.Y * ProjectionBlockSize, 0));
+		const int32 BlockEnd = FindFirstNodeFrom(FirstKey + KeysPerBlock, MIN_int32);
+		for (int32 Node = FindFirstNodeFrom(FirstKey, MIN_int32); Node < BlockEnd; ++Node) {
+			const FIntVector3& NodeLocation = Locations[Node];
+			if (NodeLocation.X < MinX || NodeLocation.X > MaxX || NodeLocation.Y < MinY || NodeLocation.Y > MaxY || NodeLocation.Z < MinZ || NodeLocation.Z > MaxZ) {
+				continue;
+			}
+
+			// a node without traversable edges can not be walked from, so a path could never start on it
+			if (EdgeOffsets[Node] == EdgeOffsets[Node + 1]) {
+				continue;
+			}
+
+			const double DistanceSquared = FVector::DistSquared(GetNodeWorldLocation(Node), Location);
+			if (DistanceSquared < NearestDistanceSquared || (DistanceSquared == NearestDistanceSquared && NearestNode == InvalidNode)) {
+				NearestNode = static_cast<uint32>(Node);
+				NearestDistanceSquared = DistanceSquared;
+			}
+		}
+	}
+	return NearestNode;
+}
+
+SIZE_T FNavGridFrozenGraph::GetAllocatedSize() const
+{
+	return Locations.GetAllocatedSize() + EdgeOffsets.GetAllocatedSize() + Targets.GetAllocatedSize() + Costs.GetAllocatedSize()
+		+ InEdgeOffsets.GetAllocatedSize() + Sources.GetAllocatedSize() + InCosts.GetAllocatedSize();
+}
+
+int32 FNavGridFrozenGraph::FindFirstNodeFrom(const uint64 Key, const int32 Z) const
+{
+	int32 Low = 0;
+	int32 High = Locations.Num();
+	while (Low < High) {
+		const int32 Middle = Low + (High - Low) / 2;
+		const FIntVector3& MiddleLocation = Locations[Middle];
+		if (IsBefore(GetCurveKey(MiddleLocation), MiddleLocation.Z, Key, Z)) {
+			Low = Middle + 1;
+		}
+		else {
+			High = Middle;
+		}
+	}
+	return Low;
+}
+
+uint64 FNavGridFrozenGraph::GetCurveKey(const FIntVector3& Location)
+{
+	return SpreadBits(static_cast<uint32>(Location.X)) | (SpreadBits(static_cast<uint32>(Location.Y)) << 1);
+}
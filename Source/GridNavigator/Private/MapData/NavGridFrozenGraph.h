@@ -0,0 +1,229 @@
+#pragma once
+
+#include <atomic>
+
+#include "GridNavigatorConfig.h"
+#include "NavGridAdjacencyList.h"
+
+/**
+ * @class FNavGridFrozenGraph
+ * @brief A read-only copy of the navigation graph in compressed sparse row form, compiled once a build has
+ * finished so that searches do not have to walk the editable adjacency list.
+ *
+ * Nodes are numbered in the order of a Morton (Z-order) curve over their X and Y, so nodes that are close on the
+ * grid are also close in memory, and a search sweeping over part of the grid touches few cache lines. Node N has
+ * its traversable edges at [EdgeOffsets[N], EdgeOffsets[N + 1]) of Targets and Costs, so visiting its neighbors
+ * takes two array reads and no lookup.
+ *
+ * Node numbers are used as search locations directly; TAStarSearchArena indexes its records by them instead of
+ * hashing. FindNode turns a grid index into a node number by binary search along the curve.
+ *
+ * Every edge is also stored reversed, under its target, so that searches from a goal (see
+ * FNavGridFrozenReverseView) measure paths in exactly the same costs as searches towards it.
+ */
+class FNavGridFrozenGraph
+{
+public:
+	// node number reported for grid indices that are not part of the graph
+	static constexpr uint32 InvalidNode = TNumericLimits<uint32>::Max();
+
+	/**
+	 * @brief Compiles the nodes and traversable edges of a map, replacing the previous graph.
+	 *
+	 * @param Map The graph to copy; must not have any edges waiting to be compacted
+	 */
+	void Build(const FNavGridAdjacencyList& Map);
+
+	void Clear();
+
+	FORCEINLINE bool HasNode(const uint32 Node) const
+	{
+		return Node < static_cast<uint32>(Locations.Num());
+	}
+
+	/**
+	 * @brief Visits every node that can be reached from a node in a single step, without allocating.
+	 *
+	 * @param Node The node to query; must be part of the graph
+	 * @param Callable Invoked as Callable(uint32 Neighbor, double EdgeCost) for each traversable edge
+	 */
+	template <typename CallableT>
+	FORCEINLINE void ForEachReachableNeighbor(const uint32 Node, CallableT&& Callable) const
+	{
+		const int32 EdgesEnd = EdgeOffsets[Node + 1];
+		for (int32 Edge = EdgeOffsets[Node]; Edge < EdgesEnd; ++Edge) {
+			Callable(Targets[Edge], static_cast<double>(Costs[Edge]));
+		}
+	}
+
+	/**
+	 * @brief Visits every node that can reach a node in a single step, without allocating.
+	 *
+	 * @param Node The node to query; must be part of the graph
+	 * @param Callable Invoked as Callable(uint32 Neighbor, double EdgeCost) for each traversable edge into Node
+	 */
+	template <typename CallableT>
+	FORCEINLINE void ForEachReachingNeighbor(const uint32 Node, CallableT&& Callable) const
+	{
+		const int32 EdgesEnd = InEdgeOffsets[Node + 1];
+		for (int32 Edge = InEdgeOffsets[Node]; Edge < EdgesEnd; ++Edge) {
+			Callable(Sources[Edge], static_cast<double>(InCosts[Edge]));
+		}
+	}
+
+	/**
+	 * @return The number of the node at a grid index, or InvalidNode if there is no such node
+	 */
+	uint32 FindNode(const NavGrid::FAdjacencyListIndex& Index) const;
+
+	/**
+	 * @return The cost searches over the graph give the traversable edge from one node to another, or a negative
+	 * value if there is no such edge
+	 */
+	double GetEdgeCost(uint32 From, uint32 To) const;
+
+	/**
+	 * @brief Finds the traversable node nearest to a world location among the nodes inside a box around it.
+	 *
+	 * Aligned blocks of ProjectionBlockSize x ProjectionBlockSize columns occupy a single run of node numbers, so
+	 * the graph doubles as a spatial index: the blocks overlapping the box are searched nearest first, and the
+	 * search stops at the first block that is farther away than the best node found so far.
+	 *
+	 * @param Location World location to search around
+	 * @param Extent Half the size of the box, in world units
+	 * @return The node nearest to Location with at least one traversable edge, or InvalidNode if the box has none
+	 */
+	uint32 FindNearestNode(const FVector& Location, const FVector& Extent) const;
+
+	/**
+	 * @brief Finds the traversable node nearest to a world location among the nodes inside a box, which does not
+	 * have to be centered on the location.
+	 *
+	 * @param Location World location to search around
+	 * @param Bounds World space box to search in
+	 * @return The node nearest to Location with at least one traversable edge, or InvalidNode if the box has none
+	 */
+	uint32 FindNearestNode(const FVector& Location, const FBox& Bounds) const;
+
+	/**
+	 * @brief Finds the traversable node nearest to a world location within a distance of it.
+	 *
+	 * @param Location World location to search around
+	 * @param Radius Maximum distance to the node, in world units
+	 * @return The node nearest to Location with at least one traversable edge, or InvalidNode if none is in range
+	 */
+	uint32 FindNearestNode(const FVector& Location, double Radius) const;
+
+	/**
+	 * @return The grid index of a node of the graph
+	 */
+	FORCEINLINE NavGrid::FAdjacencyListIndex GetNodeIndex(const uint32 Node) const
+	{
+		const FIntVector3& Location = Locations[Node];
+		return NavGrid::FAdjacencyListIndex(OriginX + Location.X, OriginY + Location.Y, Location.Z);
+	}
+
+	/**
+	 * @return The grid index of a node relative to the graph's origin; only differences between them are meaningful
+	 */
+	FORCEINLINE const FIntVector3& GetNodeLocation(const uint32 Node) const { return Locations[Node]; }
+
+	/**
+	 * @return The world location of a node of the graph
+	 */
+	FORCEINLINE FVector GetNodeWorldLocation(const uint32 Node) const
+	{
+		return GridNavigatorConfig::GridIndexToWorld(GetNodeIndex(Node));
+	}
+
+	FORCEINLINE int32 GetNumNodes() const { return Locations.Num(); }
+	FORCEINLINE int32 GetNumEdges() const { return Targets.Num(); }
+	FORCEINLINE bool IsEmpty() const { return Locations.IsEmpty(); }
+
+	/**
+	 * @return A number that changes every time the graph is built, and is never the same for two builds of any
+	 * graph; 0 for a graph that has not been built
+	 */
+	FORCEINLINE uint32 GetGeneration() const { return Generation; }
+
+	/**
+	 * @return Number of bytes used by the graph
+	 */
+	SIZE_T GetAllocatedSize() const;
+
+	// width and depth, in grid cells, of the blocks FindNearestNode searches one at a time
+	static constexpr int32 ProjectionBlockSize = 16;
+
+private:
+	uint32 FindNearestNode(const FVector& Location, const FBox& Bounds, double MaxDistanceSquared) const;
+
+	/**
+	 * @return The first node that does not come before a location in node order, or the number of nodes if there is none
+	 */
+	int32 FindFirstNodeFrom(uint64 Key, int32 Z) const;
+
+	/**
+	 * @return The position of a location along the curve, found by interleaving the bits of its X and Y
+	 */
+	static uint64 GetCurveKey(const FIntVector3& Location);
+
+	/**
+	 * @return \c true if location A comes before location B in node order: along the curve, then from the bottom up
+	 */
+	static FORCEINLINE bool IsBefore(const uint64 KeyA, const int32 ZA, const uint64 KeyB, const int32 ZB)
+	{
+		return KeyA < KeyB || (KeyA == KeyB && ZA < ZB);
+	}
+
+	// grid index of every node in node order, with X and Y relative to the origin so that they are never negative
+	TArray<FIntVector3> Locations;
+	int64 OriginX = 0;
+	int64 OriginY = 0;
+
+	// one past the largest relative X and Y of any node
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+
+	// NumNodes + 1 entries; the edges of node N are [EdgeOffsets[N], EdgeOffsets[N + 1])
+	TArray<int32> EdgeOffsets;
+	TArray<uint32> Targets;
+
+	// rounded up from the adjacency list's costs, so that heuristics admissible for those stay admissible here
+	TArray<float> Costs;
+
+	// the same edges grouped by target; the edges into node N are [InEdgeOffsets[N], InEdgeOffsets[N + 1])
+	TArray<int32> InEdgeOffsets;
+	TArray<uint32> Sources;
+	TArray<float> InCosts;
+
+	uint32 Generation = 0;
+	static inline std::atomic<uint32> NextGeneration = 1;
+};
+
+/**
+ * @class FNavGridFrozenReverseView
+ * @brief Presents a frozen graph with every edge reversed, so that searches over it run from the goal back
+ * towards the start.
+ *
+ * Satisfies can_query_nodes, so it can be handed to any of the search templates in place of the graph itself.
+ * The view only references the graph, which must outlive it.
+ */
+class FNavGridFrozenReverseView
+{
+public:
+	explicit FNavGridFrozenReverseView(const FNavGridFrozenGraph& NewGraph) : Graph(&NewGraph) {}
+
+	FORCEINLINE bool HasNode(const uint32 Node) const
+	{
+		return Graph->HasNode(Node);
+	}
+
+	template <typename CallableT>
+	FORCEINLINE void ForEachReachableNeighbor(const uint32 Node, CallableT&& Callable) const
+	{
+		Graph->ForEachReachingNeighbor(Node, Forward<CallableT>(Callable));
+	}
+
+private:
+	const FNavGridFrozenGraph* Graph;
+};
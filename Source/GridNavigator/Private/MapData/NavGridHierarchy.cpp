@@ -0,0 +1,494 @@
+#include "NavGridHierarchy.h"
+
+#include "GridNavigatorConfig.h"
+#include "Navigation/AStarNavigator.h"
+#include "Navigation/DijkstraSearch.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogNavGridHierarchy, Log, All)
+
+using NavGrid::FAdjacencyListIndex;
+
+namespace
+{
+	// border runs shorter than this get a single entrance in their middle; longer runs get one at each end
+	constexpr int32 MinRunLengthForTwoEntrances = 6;
+
+	/**
+	 * @brief Restricts a map to the nodes of a rectangular range of clusters, so searches over it never leave
+	 * that range.
+	 */
+	class FClusterView
+	{
+	public:
+		FClusterView(const FNavGridAdjacencyList& NewMap, const FIntPoint& ClusterKey) : FClusterView(NewMap, ClusterKey, ClusterKey) {}
+		FClusterView(const FNavGridAdjacencyList& NewMap, const FIntPoint& NewMinKey, const FIntPoint& NewMaxKey) : Map(NewMap), MinKey(NewMinKey), MaxKey(NewMaxKey) {}
+
+		bool HasNode(const int64 X, const int64 Y, const int64 Z) const
+		{
+			return HasNode(FAdjacencyListIndex(X, Y, Z));
+		}
+
+		bool HasNode(const FAdjacencyListIndex& Index) const
+		{
+			return Contains(Index) && Map.HasNode(Index);
+		}
+
+		template <typename CallableT>
+		void ForEachReachableNeighbor(const FAdjacencyListIndex& Index, CallableT&& Callable) const
+		{
+			Map.ForEachReachableNeighbor(Index, [this, &Callable](const FAdjacencyListIndex& Neighbor, const double EdgeCost)
+			{
+				if (Contains(Neighbor)) {
+					Callable(Neighbor, EdgeCost);
+				}
+			});
+		}
+
+		/**
+		 * @return A view over the smallest range of clusters that contains both grid nodes
+		 */
+		static FClusterView Spanning(const FNavGridAdjacencyList& Map, const FAdjacencyListIndex& Lhs, const FAdjacencyListIndex& Rhs)
+		{
+			const FIntPoint LhsKey = FNavGridHierarchy::GetClusterKey(Lhs);
+			const FIntPoint RhsKey = FNavGridHierarchy::GetClusterKey(Rhs);
+			return FClusterView(
+				Map,
+				FIntPoint(FMath::Min(LhsKey.X, RhsKey.X), FMath::Min(LhsKey.Y, RhsKey.Y)),
+				FIntPoint(FMath::Max(LhsKey.X, RhsKey.X), FMath::Max(LhsKey.Y, RhsKey.Y))
+			);
+		}
+
+	private:
+		bool Contains(const FAdjacencyListIndex& Index) const
+		{
+			const FIntPoint Key = FNavGridHierarchy::GetClusterKey(Index);
+			return Key.X >= MinKey.X && Key.X <= MaxKey.X && Key.Y >= MinKey.Y && Key.Y <= MaxKey.Y;
+		}
+
+		const FNavGridAdjacencyList& Map;
+		FIntPoint MinKey;
+		FIntPoint MaxKey;
+	};
+
+	typedef TDijkstraSearch<FClusterView, FAdjacencyListIndex> FClusterDijkstra;
+
+	bool HasTraversableEdge(const FNavGridAdjacencyList& Map, const FAdjacencyListIndex& From, const FAdjacencyListIndex& To)
+	{
+		return Map.FindTraversableEdge(From, To).has_value();
+	}
+
+	bool IsIndexLess(const FAdjacencyListIndex& Lhs, const FAdjacencyListIndex& Rhs)
+	{
+		if (Lhs.X != Rhs.X) return Lhs.X < Rhs.X;
+		if (Lhs.Y != Rhs.Y) return Lhs.Y < Rhs.Y;
+		return Lhs.Z < Rhs.Z;
+	}
+
+	/**
+	 * @brief Finds the entrance node pairs on the border between two neighboring clusters.
+	 *
+	 * Crossing edges are grouped into runs of border nodes that are connected to each other along the border,
+	 * and each run is reduced to one or two representative crossings. Both clusters must see the same
+	 * entrances regardless of which side asks, so pairs are always computed in a canonical cluster order.
+	 *
+	 * @return Pairs of (node in ClusterKey, node in NeighborKey)
+	 */
+	TArray<TPair<FAdjacencyListIndex, FAdjacencyListIndex>> FindBorderEntrances(
+		const FNavGridAdjacencyList& Map,
+		const TMap<FIntPoint, TArray<FAdjacencyListIndex>>& ClusterNodes,
+		const FIntPoint& ClusterKey,
+		const FIntPoint& NeighborKey)
+	{
+		const bool bIsCanonicalOrder = ClusterKey.X < NeighborKey.X || (ClusterKey.X == NeighborKey.X && ClusterKey.Y < NeighborKey.Y);
+		const FIntPoint& LowKey  = bIsCanonicalOrder ? ClusterKey : NeighborKey;
+		const FIntPoint& HighKey = bIsCanonicalOrder ? NeighborKey : ClusterKey;
+
+		// gather every crossing in either direction, keyed by its node on the low side of the border
+		TMap<FAdjacencyListIndex, FAdjacencyListIndex> Crossings;
+		const auto GatherCrossings = [&](const FIntPoint& FromKey, const FIntPoint& ToKey, const bool bFromIsLow)
+		{
+			const auto* FromNodes = ClusterNodes.Find(FromKey);
+			if (!FromNodes) {
+				return;
+			}
+			for (const auto& FromIndex : *FromNodes) {
+				Map.ForEachReachableNeighbor(FromIndex, [&](const FAdjacencyListIndex& ToIndex, double)
+				{
+					if (FNavGridHierarchy::GetClusterKey(ToIndex) != ToKey) {
+						return;
+					}
+					const FAdjacencyListIndex& LowIndex  = bFromIsLow ? FromIndex : ToIndex;
+					const FAdjacencyListIndex& HighIndex = bFromIsLow ? ToIndex : FromIndex;
+					const auto* ExistingHighIndex = Crossings.Find(LowIndex);
+					if (!ExistingHighIndex || IsIndexLess(HighIndex, *ExistingHighIndex)) {
+						Crossings.Add(LowIndex, HighIndex);
+					}
+				});
+			}
+		};
+		GatherCrossings(LowKey, HighKey, true);
+		GatherCrossings(HighKey, LowKey, false);
+
+		TArray<TPair<FAdjacencyListIndex, FAdjacencyListIndex>> SortedCrossings;
+		SortedCrossings.Reserve(Crossings.Num());
+		for (const auto& [LowIndex, HighIndex] : Crossings) {
+			SortedCrossings.Emplace(LowIndex, HighIndex);
+		}
+		SortedCrossings.Sort([](const auto& Lhs, const auto& Rhs) { return IsIndexLess(Lhs.Key, Rhs.Key); });
+
+		TArray<TPair<FAdjacencyListIndex, FAdjacencyListIndex>> Result;
+		const auto AddEntrance = [&](const TPair<FAdjacencyListIndex, FAdjacencyListIndex>& Crossing)
+		{
+			if (bIsCanonicalOrder) {
+				Result.Emplace(Crossing.Key, Crossing.Value);
+			}
+			else {
+				Result.Emplace(Crossing.Value, Crossing.Key);
+			}
+		};
+
+		int32 RunStart = 0;
+		for (int32 i = 1; i <= SortedCrossings.Num(); ++i) {
+			const bool bRunContinues = i < SortedCrossings.Num()
+				&& HasTraversableEdge(Map, SortedCrossings[i - 1].Key, SortedCrossings[i].Key)
+				&& HasTraversableEdge(Map, SortedCrossings[i].Key, SortedCrossings[i - 1].Key);
+			if (bRunContinues) {
+				continue;
+			}
+
+			const int32 RunLength = i - RunStart;
+			if (RunLength < MinRunLengthForTwoEntrances) {
+				AddEntrance(SortedCrossings[RunStart + RunLength / 2]);
+			}
+			else {
+				AddEntrance(SortedCrossings[RunStart]);
+				AddEntrance(SortedCrossings[i - 1]);
+			}
+			RunStart = i;
+		}
+
+		return Result;
+	}
+}
+
+FNavGridHierarchicalPath::FNavGridHierarchicalPath(const FNavGridAdjacencyList& NewMap, TArray<FAdjacencyListIndex>&& NewWaypoints)
+	: Map(&NewMap), Waypoints(MoveTemp(NewWaypoints))
+{
+	if (!Waypoints.IsEmpty()) {
+		RefinedNodes.Add(Waypoints[0]);
+	}
+}
+
+FNavGridHierarchicalPath FNavGridHierarchicalPath::MakeRefined(const FNavGridAdjacencyList& NewMap, TArray<FAdjacencyListIndex>&& NewNodes)
+{
+	FNavGridHierarchicalPath Result;
+	if (NewNodes.IsEmpty()) {
+		return Result;
+	}
+	Result.Map = &NewMap;
+	Result.Waypoints = { NewNodes[0], NewNodes.Last() };
+	Result.RefinedNodes = MoveTemp(NewNodes);
+	Result.NextSegment = 1;
+	return Result;
+}
+
+bool FNavGridHierarchicalPath::RefineNextSegment()
+{
+	if (!IsValid() || IsFullyRefined()) {
+		return false;
+	}
+
+	const FAdjacencyListIndex& SegmentStart = Waypoints[NextSegment];
+	const FAdjacencyListIndex& SegmentEnd   = Waypoints[NextSegment + 1];
+
+	// entrances in different clusters are joined by a single crossing edge
+	const FAdjacencyListIndex Delta = SegmentEnd - SegmentStart;
+	const bool bIsCrossingEdge = FNavGridHierarchy::GetClusterKey(SegmentStart) != FNavGridHierarchy::GetClusterKey(SegmentEnd)
+		&& NavGrid::GetDirectionIndex(Delta.X, Delta.Y) != INDEX_NONE;
+	if (bIsCrossingEdge) {
+		RefinedNodes.Add(SegmentEnd);
+		++NextSegment;
+		return true;
+	}
+
+	TAStarNavigator<FClusterView, FAdjacencyListIndex> Navigator;
+	const TArray<FAdjacencyListIndex> SegmentNodes = Navigator.Navigate(FClusterView::Spanning(*Map, SegmentStart, SegmentEnd), SegmentStart, SegmentEnd);
+	if (SegmentNodes.IsEmpty()) {
+		UE_LOG(LogNavGridHierarchy, Warning, TEXT("Failed to refine hierarchical path segment %d; the hierarchy may be out of date"), NextSegment);
+		return false;
+	}
+
+	// first node of the segment is the last node of the previous one
+	for (int32 i = 1; i < SegmentNodes.Num(); ++i) {
+		RefinedNodes.Add(SegmentNodes[i]);
+	}
+	++NextSegment;
+	return true;
+}
+
+TArray<FAdjacencyListIndex> FNavGridHierarchicalPath::RefineAll()
+{
+	while (!IsFullyRefined()) {
+		if (!RefineNextSegment()) {
+			return {};
+		}
+	}
+	return RefinedNodes;
+}
+
+FIntPoint FNavGridHierarchy::GetClusterKey(const FAdjacencyListIndex& Index)
+{
+	constexpr int64 ClusterSize = GridNavigatorConfig::HierarchyClusterSize;
+	const int64 ClusterX = Index.X >= 0 ? Index.X / ClusterSize : (Index.X - ClusterSize + 1) / ClusterSize;
+	const int64 ClusterY = Index.Y >= 0 ? Index.Y / ClusterSize : (Index.Y - ClusterSize + 1) / ClusterSize;
+	return FIntPoint(static_cast<int32>(ClusterX), static_cast<int32>(ClusterY));
+}
+
+void FNavGridHierarchy::Clear()
+{
+	Clusters.Empty();
+	AbstractEdges.Empty();
+}
+
+void FNavGridHierarchy::RebuildClusters(const FNavGridAdjacencyList& Map, TConstArrayView<FBox> WorldBounds)
+{
+	// clusters whose contents changed, plus every cluster that shares a border with one of them
+	TSet<FIntPoint> DirtyClusters;
+	for (const FBox& Bounds : WorldBounds) {
+		const FIntPoint MinKey = GetClusterKey(GridNavigatorConfig::WorldToGridIndex(Bounds.Min));
+		const FIntPoint MaxKey = GetClusterKey(GridNavigatorConfig::WorldToGridIndex(Bounds.Max));
+		for (int32 X = MinKey.X - 1; X <= MaxKey.X + 1; ++X) {
+			for (int32 Y = MinKey.Y - 1; Y <= MaxKey.Y + 1; ++Y) {
+				DirtyClusters.Add(FIntPoint(X, Y));
+			}
+		}
+	}
+
+	RebuildDirtyClusters(Map, DirtyClusters);
+}
+
+void FNavGridHierarchy::UpdateClusters(const FNavGridAdjacencyList& Map, TConstArrayView<FAdjacencyListIndex> ChangedNodes)
+{
+	// clusters holding a changed node, plus every cluster that shares a border with one of them
+	TSet<FIntPoint> DirtyClusters;
+	TSet<FIntPoint> ChangedClusters;
+	for (const FAdjacencyListIndex& Index : ChangedNodes) {
+		const FIntPoint ClusterKey = GetClusterKey(Index);
+		if (ChangedClusters.Contains(ClusterKey)) {
+			continue;
+		}
+		ChangedClusters.Add(ClusterKey);
+		for (int32 X = -1; X <= 1; ++X) {
+			for (int32 Y = -1; Y <= 1; ++Y) {
+				DirtyClusters.Add(FIntPoint(ClusterKey.X + X, ClusterKey.Y + Y));
+			}
+		}
+	}
+
+	if (!DirtyClusters.IsEmpty()) {
+		RebuildDirtyClusters(Map, DirtyClusters);
+	}
+}
+
+void FNavGridHierarchy::RebuildDirtyClusters(const FNavGridAdjacencyList& Map, const TSet<FIntPoint>& DirtyClusters)
+{
+	// entrances depend on both sides of a border, so nodes of the clusters around the dirty ones are needed too
+	TSet<FIntPoint> NeededClusters;
+	for (const FIntPoint& ClusterKey : DirtyClusters) {
+		for (int32 X = -1; X <= 1; ++X) {
+			for (int32 Y = -1; Y <= 1; ++Y) {
+				NeededClusters.Add(FIntPoint(ClusterKey.X + X, ClusterKey.Y + Y));
+			}
+		}
+	}
+
+	// each cluster's nodes are looked up by its region, so the rest of the map is never visited
+	constexpr int64 ClusterSize = GridNavigatorConfig::HierarchyClusterSize;
+	TMap<FIntPoint, TArray<FAdjacencyListIndex>> ClusterNodes;
+	for (const FIntPoint& ClusterKey : NeededClusters) {
+		const FNavGridAdjacencyList::FRegion Region = {
+			FAdjacencyListIndex(ClusterKey.X * ClusterSize, ClusterKey.Y * ClusterSize, TNumericLimits<int64>::Lowest()),
+			FAdjacencyListIndex((ClusterKey.X + 1) * ClusterSize - 1, (ClusterKey.Y + 1) * ClusterSize - 1, TNumericLimits<int64>::Max())
+		};
+		for (const NavGrid::FNodeView Node : Map.GetNodes(Region)) {
+			ClusterNodes.FindOrAdd(ClusterKey).Add(Node.Index);
+		}
+	}
+
+	for (const FIntPoint& ClusterKey : DirtyClusters) {
+		if (const FCluster* OldCluster = Clusters.Find(ClusterKey)) {
+			for (const auto& Entrance : OldCluster->Entrances) {
+				AbstractEdges.Remove(Entrance);
+			}
+			Clusters.Remove(ClusterKey);
+		}
+	}
+
+	// entrances and the edges that cross cluster borders
+	for (const FIntPoint& ClusterKey : DirtyClusters) {
+		if (!ClusterNodes.Contains(ClusterKey)) {
+			continue;
+		}
+
+		FCluster& Cluster = Clusters.Add(ClusterKey);
+		for (int32 Direction = 0; Direction < NavGrid::NumDirections; ++Direction) {
+			const FIntPoint NeighborKey(ClusterKey.X + NavGrid::DirectionOffsetX[Direction], ClusterKey.Y + NavGrid::DirectionOffsetY[Direction]);
+			for (const auto& [Entrance, NeighborEntrance] : FindBorderEntrances(Map, ClusterNodes, ClusterKey, NeighborKey)) {
+				Cluster.Entrances.AddUnique(Entrance);
+				auto& EntranceEdges = AbstractEdges.FindOrAdd(Entrance);
+				if (const std::optional<NavGrid::FEdge> CrossingEdge = Map.FindTraversableEdge(Entrance, NeighborEntrance)) {
+					EntranceEdges.Add({ NeighborEntrance, CrossingEdge->Cost });
+				}
+			}
+		}
+	}
+
+	// precomputed costs between every pair of entrances within a cluster
+	FClusterDijkstra::FSearchArena Arena;
+	for (const FIntPoint& ClusterKey : DirtyClusters) {
+		const FCluster* Cluster = Clusters.Find(ClusterKey);
+		if (!Cluster) {
+			continue;
+		}
+
+		const FClusterView View(Map, ClusterKey);
+		for (const auto& Entrance : Cluster->Entrances) {
+			FClusterDijkstra::Run(View, Entrance, Arena);
+
+			auto& EntranceEdges = AbstractEdges.FindOrAdd(Entrance);
+			for (const auto& OtherEntrance : Cluster->Entrances) {
+				const double Cost = FClusterDijkstra::GetCost(Arena, OtherEntrance);
+				if (OtherEntrance != Entrance && Cost >= 0.0) {
+					EntranceEdges.Add({ OtherEntrance, Cost });
+				}
+			}
+		}
+	}
+
+	UE_LOG(LogNavGridHierarchy, Verbose, TEXT("Rebuilt %d hierarchy clusters; hierarchy now has %d entrances"), DirtyClusters.Num(), AbstractEdges.Num());
+}
+
+FNavGridHierarchicalPath FNavGridHierarchy::FindPath(const FNavGridAdjacencyList& Map, const FAdjacencyListIndex& Start, const FAdjacencyListIndex& Goal, const double CostLimit) const
+{
+	if (!Map.HasNode(Start) || !Map.HasNode(Goal)) {
+		return {};
+	}
+
+	const FIntPoint StartKey = GetClusterKey(Start);
+	const FIntPoint GoalKey  = GetClusterKey(Goal);
+
+	// entrances are too coarse for short queries, so search the clusters involved directly when they touch
+	const bool bAreClustersAdjacent = FMath::Abs(StartKey.X - GoalKey.X) <= 1 && FMath::Abs(StartKey.Y - GoalKey.Y) <= 1;
+	if (bAreClustersAdjacent) {
+		TAStarNavigator<FClusterView, FAdjacencyListIndex> Navigator;
+		Navigator.CostLimit = CostLimit;
+		TArray<FAdjacencyListIndex> LocalPath = Navigator.Navigate(FClusterView::Spanning(Map, Start, Goal), Start, Goal);
+		if (!LocalPath.IsEmpty()) {
+			return FNavGridHierarchicalPath::MakeRefined(Map, MoveTemp(LocalPath));
+		}
+	}
+
+	static thread_local FClusterDijkstra::FSearchArena DijkstraArena;
+	static thread_local FClusterDijkstra::FSearchArena AbstractArena;
+
+	// temporarily connect the start to its cluster's entrances, and directly to the goal if they share a cluster
+	TArray<FAbstractEdge> StartEdges;
+	FClusterDijkstra::Run(FClusterView(Map, StartKey), Start, DijkstraArena, CostLimit);
+	if (const FCluster* StartCluster = Clusters.Find(StartKey)) {
+		for (const auto& Entrance : StartCluster->Entrances) {
+			const double Cost = FClusterDijkstra::GetCost(DijkstraArena, Entrance);
+			if (Entrance != Start && Cost >= 0.0) {
+				StartEdges.Add({ Entrance, Cost });
+			}
+		}
+	}
+	if (StartKey == GoalKey) {
+		const double Cost = FClusterDijkstra::GetCost(DijkstraArena, Goal);
+		if (Cost >= 0.0) {
+			StartEdges.Add({ Goal, Cost });
+		}
+	}
+
+	// and connect the goal cluster's entrances to the goal
+	TMap<FAdjacencyListIndex, double> GoalCosts;
+	if (const FCluster* GoalCluster = Clusters.Find(GoalKey)) {
+		const FClusterView GoalView(Map, GoalKey);
+		for (const auto& Entrance : GoalCluster->Entrances) {
+			FClusterDijkstra::Run(GoalView, Entrance, DijkstraArena, CostLimit);
+			const double Cost = FClusterDijkstra::GetCost(DijkstraArena, Goal);
+			if (Cost >= 0.0) {
+				GoalCosts.Add(Entrance, Cost);
+			}
+		}
+	}
+
+	AbstractArena.Reset();
+	auto& OpenSet = AbstractArena.OpenSet;
+
+	bool bWasAdded = false;
+	const int32 StartSlot = AbstractArena.FindOrAdd(Start, bWasAdded);
+	AbstractArena[StartSlot].GCost = 0.0;
+	OpenSet.Push(StartSlot, 0.0);
+
+	int32 CurrSlot = INDEX_NONE;
+	bool bFoundGoal = false;
+	while (!OpenSet.IsEmpty()) {
+		CurrSlot = OpenSet.Pop();
+		if (AbstractArena[CurrSlot].bClosed) {
+			continue;
+		}
+		AbstractArena[CurrSlot].bClosed = true;
+
+		const FAdjacencyListIndex CurrIndex = AbstractArena[CurrSlot].Location;
+		const double CurrCost = AbstractArena[CurrSlot].GCost;
+		if (CurrIndex == Goal) {
+			bFoundGoal = true;
+			break;
+		}
+
+		const auto Relax = [&](const FAdjacencyListIndex& Target, const double EdgeCost)
+		{
+			const double TargetCost = CurrCost + EdgeCost;
+			const double Priority = TargetCost + GridNavigatorSearch::FOctileHeuristic2D::Estimate(Target, Goal);
+			if (Priority > CostLimit) {
+				return;
+			}
+
+			const int32 TargetSlot = AbstractArena.FindOrAdd(Target, bWasAdded);
+			auto& TargetRecord = AbstractArena[TargetSlot];
+			if (TargetCost < TargetRecord.GCost) {
+				TargetRecord.ParentSlot = CurrSlot;
+				TargetRecord.GCost = TargetCost;
+				TargetRecord.bClosed = false;
+				OpenSet.Push(TargetSlot, Priority);
+			}
+		};
+
+		if (CurrSlot == StartSlot) {
+			for (const auto& [Target, Cost] : StartEdges) {
+				Relax(Target, Cost);
+			}
+		}
+		if (const auto* Edges = AbstractEdges.Find(CurrIndex)) {
+			for (const auto& [Target, Cost] : *Edges) {
+				Relax(Target, Cost);
+			}
+		}
+		if (const double* GoalCost = GoalCosts.Find(CurrIndex)) {
+			Relax(Goal, *GoalCost);
+		}
+	}
+
+	if (!bFoundGoal) {
+		return {};
+	}
+
+	TArray<FAdjacencyListIndex> Waypoints;
+	while (CurrSlot != INDEX_NONE) {
+		Waypoints.Add(AbstractArena[CurrSlot].Location);
+		CurrSlot = AbstractArena[CurrSlot].ParentSlot;
+	}
+	Algo::Reverse(Waypoints);
+
+	return FNavGridHierarchicalPath(Map, MoveTemp(Waypoints));
+}
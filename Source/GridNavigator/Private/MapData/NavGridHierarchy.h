@@ -0,0 +1,142 @@
+#pragma once
+
+#include "NavGridAdjacencyList.h"
+
+class FNavGridHierarchy;
+
+/**
+ * @class FNavGridHierarchicalPath
+ * @brief The result of a hierarchical query: a path through cluster entrances that is refined into grid
+ * nodes one segment at a time.
+ *
+ * Segments are refined on demand, so a caller can start acting on the first part of a long path before
+ * the rest of it has been searched. The path keeps references to the map and hierarchy it was found in,
+ * so it must not outlive either of them, and neither may be rebuilt while the path is being refined.
+ */
+class FNavGridHierarchicalPath
+{
+public:
+	FNavGridHierarchicalPath() = default;
+	FNavGridHierarchicalPath(const FNavGridAdjacencyList& NewMap, TArray<NavGrid::FAdjacencyListIndex>&& NewWaypoints);
+
+	/**
+	 * @brief Wraps a grid path that has already been found in full as a single, refined segment.
+	 */
+	static FNavGridHierarchicalPath MakeRefined(const FNavGridAdjacencyList& NewMap, TArray<NavGrid::FAdjacencyListIndex>&& NewNodes);
+
+	/**
+	 * @return \c true if the abstract search found a route from the start to the goal; \c false otherwise
+	 */
+	FORCEINLINE bool IsValid() const { return Map != nullptr && !Waypoints.IsEmpty(); }
+
+	/**
+	 * @return \c true once every segment has been refined into grid nodes
+	 */
+	FORCEINLINE bool IsFullyRefined() const { return NextSegment >= Waypoints.Num() - 1; }
+
+	/**
+	 * @brief Refines the next unrefined segment and appends its grid nodes to the refined path.
+	 *
+	 * @return \c true if a segment was refined; \c false if the path is invalid, already fully refined,
+	 * or the segment could not be refined (in which case the refined path is left unchanged)
+	 */
+	bool RefineNextSegment();
+
+	/**
+	 * @brief Refines every remaining segment.
+	 *
+	 * @return The full grid path from start to goal, or an empty array if any segment failed to refine
+	 */
+	TArray<NavGrid::FAdjacencyListIndex> RefineAll();
+
+	/**
+	 * @return The grid nodes of every segment that has been refined so far, starting at the start node
+	 */
+	FORCEINLINE const TArray<NavGrid::FAdjacencyListIndex>& GetRefinedNodes() const { return RefinedNodes; }
+
+	/**
+	 * @return The abstract path: the start node, each cluster entrance that is passed through, and the goal node
+	 */
+	FORCEINLINE const TArray<NavGrid::FAdjacencyListIndex>& GetWaypoints() const { return Waypoints; }
+
+private:
+	const FNavGridAdjacencyList* Map = nullptr;
+	TArray<NavGrid::FAdjacencyListIndex> Waypoints;
+	TArray<NavGrid::FAdjacencyListIndex> RefinedNodes;
+	int32 NextSegment = 0;
+};
+
+/**
+ * @class FNavGridHierarchy
+ * @brief An abstract graph over fixed-size clusters of the navigation grid, used for hierarchical (HPA*) search.
+ *
+ * The grid is split into square columns of GridNavigatorConfig::HierarchyClusterSize cells. Each border
+ * between two clusters is reduced to a few entrance nodes, and every pair of entrances within a cluster is
+ * connected by an abstract edge holding the precomputed cost of the shortest path between them that stays
+ * inside the cluster. Queries search this much smaller graph first, then refine only the clusters the path
+ * actually passes through.
+ */
+class FNavGridHierarchy
+{
+public:
+	struct FAbstractEdge
+	{
+		NavGrid::FAdjacencyListIndex Target;
+		double Cost;
+	};
+
+	/**
+	 * @brief Rebuilds the clusters that overlap any of the provided bounds, along with the borders they share
+	 * with neighboring clusters.
+	 *
+	 * @param Map The grid to build the abstract graph from
+	 * @param WorldBounds World-space regions of the grid that have changed (eg. rebuilt navigation blocks)
+	 */
+	void RebuildClusters(const FNavGridAdjacencyList& Map, TConstArrayView<FBox> WorldBounds);
+
+	/**
+	 * @brief Brings the hierarchy up to date with an edit to the map it was built from, rebuilding only the
+	 * clusters that hold a changed node, along with the borders they share with neighboring clusters.
+	 *
+	 * @param Map The grid as it is after the edit
+	 * @param ChangedNodes The nodes whose traversable edges differ between the two maps (see FNavGridAdjacencyList::GetChangedNodes)
+	 */
+	void UpdateClusters(const FNavGridAdjacencyList& Map, TConstArrayView<NavGrid::FAdjacencyListIndex> ChangedNodes);
+
+	/**
+	 * @brief Searches the abstract graph for a path between two grid nodes.
+	 *
+	 * @param Map The grid the hierarchy was built from
+	 * @param Start The grid node to start from
+	 * @param Goal The grid node to find a path to
+	 * @param CostLimit Abstract paths that cost more than this, in grid cells, are not searched for
+	 * @return The abstract path, to be refined into grid nodes by the caller; invalid if no path was found
+	 */
+	FNavGridHierarchicalPath FindPath(const FNavGridAdjacencyList& Map, const NavGrid::FAdjacencyListIndex& Start, const NavGrid::FAdjacencyListIndex& Goal, double CostLimit = TNumericLimits<double>::Max()) const;
+
+	void Clear();
+
+	/**
+	 * @return The key of the cluster that contains a grid node
+	 */
+	static FIntPoint GetClusterKey(const NavGrid::FAdjacencyListIndex& Index);
+
+	/**
+	 * @return Number of entrance nodes across every cluster
+	 */
+	int32 GetNumEntrances() const { return AbstractEdges.Num(); }
+
+private:
+	struct FCluster
+	{
+		TArray<NavGrid::FAdjacencyListIndex> Entrances;
+	};
+
+	/**
+	 * @brief Rebuilds a set of clusters, which must include every neighbor of a cluster whose contents changed.
+	 */
+	void RebuildDirtyClusters(const FNavGridAdjacencyList& Map, const TSet<FIntPoint>& DirtyClusters);
+
+	TMap<FIntPoint, FCluster> Clusters;
+	TMap<NavGrid::FAdjacencyListIndex, TArray<FAbstractEdge>> AbstractEdges;
+};
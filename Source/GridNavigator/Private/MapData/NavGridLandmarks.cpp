@@ -0,0 +1,237 @@
+#include "NavGridLandmarks.h"
+
+#include "GridNavigatorStats.h"
+#include "Navigation/DijkstraSearch.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogNavGridLandmarks, Log, All)
+
+using NavGrid::FAdjacencyListIndex;
+
+namespace
+{
+	typedef TDijkstraSearch<FNavGridAdjacencyList, FAdjacencyListIndex> FForwardDijkstra;
+	typedef TDijkstraSearch<FNavGridReverseAdjacencyView, FAdjacencyListIndex> FReverseDijkstra;
+
+	/**
+	 * @return The bound Far - Near on a path cost, less the error from storing both distances as floats, or 0
+	 * if either node is cut off from the landmark
+	 */
+	FORCEINLINE double GetTriangleBound(const float Far, const float Near, const float Unreachable)
+	{
+		if (Far == Unreachable || Near == Unreachable) {
+			return 0.0;
+		}
+		const double FarCost = Far;
+		const double NearCost = Near;
+		return FarCost - NearCost - (FarCost + NearCost) * FLT_EPSILON;
+	}
+}
+
+void FNavGridLandmarks::Build(const FNavGridAdjacencyList& Map, const int32 NumLandmarks)
+{
+	Clear();
+	if (NumLandmarks <= 0) {
+		return;
+	}
+
+	Map.ForEachNode([this](const NavGrid::FNodeView& Node)
+	{
+		NodeSlots.Add(Node.Index, Nodes.Add(Node.Index));
+	});
+	if (Nodes.IsEmpty()) {
+		return;
+	}
+
+	const int32 NumNodes = Nodes.Num();
+	const int32 MaxLandmarks = FMath::Min(NumLandmarks, NumNodes);
+
+	// one column per landmark while the landmarks are being picked; interleaved per node once they are all known
+	TArray<float> FromColumns;
+	TArray<float> ToColumns;
+	FromColumns.Init(Unreachable, MaxLandmarks * NumNodes);
+	ToColumns.Init(Unreachable, MaxLandmarks * NumNodes);
+
+	// cost from the closest landmark picked so far to each node
+	TArray<double> ClosestLandmarkCost;
+	ClosestLandmarkCost.Init(TNumericLimits<double>::Max(), NumNodes);
+
+	FForwardDijkstra::FSearchArena Arena;
+	const auto CopyCosts = [&](TArray<float>& Columns, const int32 Column)
+	{
+		for (int32 ArenaSlot = 0; ArenaSlot < Arena.Num(); ++ArenaSlot) {
+			const auto& Record = Arena[ArenaSlot];
+			const int32* NodeSlot = NodeSlots.Find(Record.Location);
+			if (Record.bClosed && NodeSlot) {
+				Columns[Column * NumNodes + *NodeSlot] = static_cast<float>(Record.GCost);
+			}
+		}
+	};
+
+	// the first landmark is the node farthest from an arbitrary one, which puts it on the edge of the map
+	FForwardDijkstra::Run(Map, Nodes[0], Arena);
+	FAdjacencyListIndex NextLandmark = Nodes[0];
+	double NextLandmarkCost = 0.0;
+	for (int32 ArenaSlot = 0; ArenaSlot < Arena.Num(); ++ArenaSlot) {
+		if (Arena[ArenaSlot].bClosed && Arena[ArenaSlot].GCost > NextLandmarkCost) {
+			NextLandmark = Arena[ArenaSlot].Location;
+			NextLandmarkCost = Arena[ArenaSlot].GCost;
+		}
+	}
+
+	for (int32 Column = 0; Column < MaxLandmarks; ++Column) {
+		Landmarks.Add(NextLandmark);
+
+		FForwardDijkstra::Run(Map, NextLandmark, Arena);
+		CopyCosts(FromColumns, Column);
+		FReverseDijkstra::Run(FNavGridReverseAdjacencyView(Map), NextLandmark, Arena);
+		CopyCosts(ToColumns, Column);
+
+		// the next landmark is the node farthest from every landmark so far; nodes that none of them reach come
+		// first, so that separate areas of the map each get a landmark of their own
+		NextLandmarkCost = 0.0;
+		for (int32 NodeSlot = 0; NodeSlot < NumNodes; ++NodeSlot) {
+			const float FromCost = FromColumns[Column * NumNodes + NodeSlot];
+			const double Cost = FromCost != Unreachable ? FromCost : TNumericLimits<double>::Max();
+			ClosestLandmarkCost[NodeSlot] = FMath::Min(ClosestLandmarkCost[NodeSlot], Cost);
+
+			if (ClosestLandmarkCost[NodeSlot] > NextLandmarkCost) {
+				NextLandmark = Nodes[NodeSlot];
+				NextLandmarkCost = ClosestLandmarkCost[NodeSlot];
+			}
+		}
+
+		// every node is a landmark already
+		if (NextLandmarkCost <= 0.0) {
+			break;
+		}
+	}
+
+	const int32 NumPicked = Landmarks.Num();
+	Distances.SetNumUninitialized(NumNodes * NumPicked * 2);
+	for (int32 NodeSlot = 0; NodeSlot < NumNodes; ++NodeSlot) {
+		float* Row = Distances.GetData() + NodeSlot * NumPicked * 2;
+		for (int32 Column = 0; Column < NumPicked; ++Column) {
+			Row[Column] = FromColumns[Column * NumNodes + NodeSlot];
+			Row[NumPicked + Column] = ToColumns[Column * NumNodes + NodeSlot];
+		}
+	}
+
+	SET_MEMORY_STAT(STAT_GridNavigator_LandmarkMemory, GetAllocatedSize());
+	UE_LOG(LogNavGridLandmarks, Log, TEXT("Built %d landmarks over %d nodes, using %.1f KiB (%llu bytes per node)"),
+		NumPicked, NumNodes, GetAllocatedSize() / 1024.0, static_cast<uint64>(GetAllocatedSize() / NumNodes));
+}
+
+void FNavGridLandmarks::Clear()
+{
+	Landmarks.Empty();
+	Nodes.Empty();
+	NodeSlots.Empty();
+	Distances.Empty();
+	OrderedGeneration = 0;
+	SET_MEMORY_STAT(STAT_GridNavigator_LandmarkMemory, 0);
+}
+
+void FNavGridLandmarks::ReorderFor(const FNavGridFrozenGraph& Graph)
+{
+	if (IsEmpty() || IsOrderedFor(Graph)) {
+		OrderedGeneration = Graph.GetGeneration();
+		return;
+	}
+
+	const int32 Stride = Landmarks.Num() * 2;
+	const int32 NumNodes = Graph.GetNumNodes();
+	TArray<FAdjacencyListIndex> OrderedNodes;
+	TArray<float> OrderedDistances;
+	OrderedNodes.Reserve(NumNodes);
+	OrderedDistances.SetNumUninitialized(NumNodes * Stride);
+
+	int32 NumMissing = 0;
+	for (int32 Node = 0; Node < NumNodes; ++Node) {
+		const FAdjacencyListIndex Index = Graph.GetNodeIndex(Node);
+		float* Row = OrderedDistances.GetData() + Node * Stride;
+		OrderedNodes.Add(Index);
+
+		if (const int32* NodeSlot = NodeSlots.Find(Index)) {
+			FMemory::Memcpy(Row, Distances.GetData() + *NodeSlot * Stride, Stride * sizeof(float));
+		}
+		else {
+			for (int32 Column = 0; Column < Stride; ++Column) {
+				Row[Column] = Unreachable;
+			}
+			++NumMissing;
+		}
+	}
+
+	Nodes = MoveTemp(OrderedNodes);
+	Distances = MoveTemp(OrderedDistances);
+	NodeSlots.Reset();
+	NodeSlots.Reserve(NumNodes);
+	for (int32 NodeSlot = 0; NodeSlot < NumNodes; ++NodeSlot) {
+		NodeSlots.Add(Nodes[NodeSlot], NodeSlot);
+	}
+	OrderedGeneration = Graph.GetGeneration();
+
+	if (NumMissing > 0) {
+		UE_LOG(LogNavGridLandmarks, Warning, TEXT("%d nodes have no landmark distances; rebuild navigation to restore them"), NumMissing);
+	}
+	SET_MEMORY_STAT(STAT_GridNavigator_LandmarkMemory, GetAllocatedSize());
+}
+
+TConstArrayView<float> FNavGridLandmarks::GetDistances(const FAdjacencyListIndex& Index) const
+{
+	const int32* NodeSlot = NodeSlots.Find(Index);
+	if (!NodeSlot) {
+		return {};
+	}
+	const int32 Stride = Landmarks.Num() * 2;
+	return MakeArrayView(Distances.GetData() + *NodeSlot * Stride, Stride);
+}
+
+double FNavGridLandmarks::GetLowerBound(const TConstArrayView<float> FromDistances, const TConstArrayView<float> ToDistances)
+{
+	if (FromDistances.IsEmpty() || ToDistances.IsEmpty()) {
+		return 0.0;
+	}
+	check(FromDistances.Num() == ToDistances.Num());
+
+	const int32 NumLandmarks = FromDistances.Num() / 2;
+	double Bound = 0.0;
+	for (int32 Column = 0; Column < NumLandmarks; ++Column) {
+		// d(From, To) >= d(L, To) - d(L, From)
+		Bound = FMath::Max(Bound, GetTriangleBound(ToDistances[Column], FromDistances[Column], Unreachable));
+
+		// d(From, To) >= d(From, L) - d(To, L)
+		const int32 ToColumn = NumLandmarks + Column;
+		Bound = FMath::Max(Bound, GetTriangleBound(FromDistances[ToColumn], ToDistances[ToColumn], Unreachable));
+	}
+	return Bound;
+}
+
+SIZE_T FNavGridLandmarks::GetAllocatedSize() const
+{
+	return Landmarks.GetAllocatedSize() + Nodes.GetAllocatedSize() + NodeSlots.GetAllocatedSize() + Distances.GetAllocatedSize();
+}
+
+void FNavGridLandmarks::Serialize(FArchive& Archive)
+{
+	Archive << Landmarks;
+	Archive << Nodes;
+	Archive << Distances;
+
+	// the lookup is derived from the node order, so rebuild it rather than storing it
+	if (Archive.IsLoading()) {
+		NodeSlots.Reset();
+		OrderedGeneration = 0;
+		if (Distances.Num() != Nodes.Num() * Landmarks.Num() * 2) {
+			UE_LOG(LogNavGridLandmarks, Warning, TEXT("Discarding landmark tables with mismatched sizes; rebuild navigation to restore them"));
+			Clear();
+			return;
+		}
+
+		NodeSlots.Reserve(Nodes.Num());
+		for (int32 NodeSlot = 0; NodeSlot < Nodes.Num(); ++NodeSlot) {
+			NodeSlots.Add(Nodes[NodeSlot], NodeSlot);
+		}
+		SET_MEMORY_STAT(STAT_GridNavigator_LandmarkMemory, GetAllocatedSize());
+	}
+}
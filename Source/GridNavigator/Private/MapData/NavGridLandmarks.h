@@ -0,0 +1,161 @@
+#pragma once
+
+#include "NavGridAdjacencyList.h"
+#include "NavGridFrozenGraph.h"
+#include "Navigation/SearchPolicies.h"
+
+/**
+ * @class FNavGridLandmarks
+ * @brief Shortest path distances between every grid node and a few landmark nodes, used to bound the cost of
+ * any path through the grid from below (the ALT heuristic: A*, Landmarks, and the Triangle inequality).
+ *
+ * For a landmark L, the triangle inequality gives both d(A, B) >= d(L, B) - d(L, A) and
+ * d(A, B) >= d(A, L) - d(B, L). Unlike a straight-line estimate, these bounds account for walls and height
+ * changes, so searches on maze-like or multi-level maps expand far fewer nodes. Each landmark costs two floats
+ * per node, so the number of landmarks trades memory for search speed.
+ *
+ * Landmarks are picked by farthest-point selection: each new landmark is the node farthest from the ones already
+ * picked, which spreads them around the edges of the map where their bounds are tightest.
+ */
+class FNavGridLandmarks
+{
+public:
+	/**
+	 * @brief Picks landmarks and computes the distances between them and every node of a map, replacing any
+	 * previous tables.
+	 *
+	 * @param Map The grid to compute distances over
+	 * @param NumLandmarks Number of landmarks to pick; 0 clears the tables and disables the bound
+	 */
+	void Build(const FNavGridAdjacencyList& Map, int32 NumLandmarks);
+
+	void Clear();
+
+	FORCEINLINE bool IsEmpty() const { return Landmarks.IsEmpty(); }
+	FORCEINLINE int32 GetNumLandmarks() const { return Landmarks.Num(); }
+	FORCEINLINE const TArray<NavGrid::FAdjacencyListIndex>& GetLandmarks() const { return Landmarks; }
+
+	/**
+	 * @return The distance table of a node: its distance from each landmark followed by its distance to each
+	 * landmark, in grid cells; empty if the node was not part of the map the tables were built from
+	 */
+	TConstArrayView<float> GetDistances(const NavGrid::FAdjacencyListIndex& Index) const;
+
+	/**
+	 * @brief Rearranges the tables into the node order of a frozen graph, so that searches over the graph can find
+	 * a node's table from its number alone (see GetFrozenDistances). Nodes of the graph that the tables were not
+	 * built for are given a table of unreachable distances, which bounds nothing.
+	 */
+	void ReorderFor(const FNavGridFrozenGraph& Graph);
+
+	/**
+	 * @return \c true if the tables are in the node order of the graph as it is now built
+	 */
+	FORCEINLINE bool IsOrderedFor(const FNavGridFrozenGraph& Graph) const
+	{
+		return OrderedGeneration != 0 && OrderedGeneration == Graph.GetGeneration();
+	}
+
+	/**
+	 * @return The distance table of a node of the graph the tables were last reordered for (see GetDistances)
+	 */
+	FORCEINLINE TConstArrayView<float> GetFrozenDistances(const uint32 Node) const
+	{
+		const int32 Stride = Landmarks.Num() * 2;
+		return MakeArrayView(Distances.GetData() + static_cast<int64>(Node) * Stride, Stride);
+	}
+
+	/**
+	 * @return A lower bound on the cost of the shortest path from the node with FromDistances to the node with
+	 * ToDistances, or 0 if either table is empty
+	 */
+	static double GetLowerBound(TConstArrayView<float> FromDistances, TConstArrayView<float> ToDistances);
+
+	/**
+	 * @return Number of bytes used by the distance tables
+	 */
+	SIZE_T GetAllocatedSize() const;
+
+	void Serialize(FArchive& Archive);
+
+private:
+	// stored for nodes that cannot reach, or be reached from, a landmark
+	static constexpr float Unreachable = TNumericLimits<float>::Max();
+
+	TArray<NavGrid::FAdjacencyListIndex> Landmarks;
+
+	// nodes in table order; Distances holds 2 * Landmarks.Num() entries for each of them
+	TArray<NavGrid::FAdjacencyListIndex> Nodes;
+	TMap<NavGrid::FAdjacencyListIndex, int32> NodeSlots;
+	TArray<float> Distances;
+
+	// generation of the frozen graph whose node order the tables are in, or 0 if they are in an order of their own
+	uint32 OrderedGeneration = 0;
+};
+
+/**
+ * @brief Heuristic policy that combines the octile distance with the landmark lower bound, taking whichever is
+ * larger. Falls back to the octile distance alone when no landmark tables are available.
+ *
+ * Holds a pointer to the tables, which must outlive any search using it. The goal's distance table is looked
+ * up once, when the heuristic is made, rather than on every estimate.
+ */
+struct FNavGridLandmarkHeuristic
+{
+	FNavGridLandmarkHeuristic() = default;
+	FNavGridLandmarkHeuristic(const FNavGridLandmarks& NewLandmarks, const NavGrid::FAdjacencyListIndex& NewGoal)
+		: Landmarks(&NewLandmarks), Goal(NewGoal), GoalDistances(NewLandmarks.GetDistances(NewGoal)) {}
+
+	FORCEINLINE double Estimate(const NavGrid::FAdjacencyListIndex& From, const NavGrid::FAdjacencyListIndex& To) const
+	{
+		const double Octile = GridNavigatorSearch::FOctileHeuristic2D::Estimate(From, To);
+		if (!Landmarks) {
+			return Octile;
+		}
+
+		const TConstArrayView<float> ToDistances = To == Goal ? GoalDistances : Landmarks->GetDistances(To);
+		return FMath::Max(Octile, FNavGridLandmarks::GetLowerBound(Landmarks->GetDistances(From), ToDistances));
+	}
+
+private:
+	const FNavGridLandmarks* Landmarks = nullptr;
+	NavGrid::FAdjacencyListIndex Goal;
+	TConstArrayView<float> GoalDistances;
+};
+
+/**
+ * @brief The same heuristic as FNavGridLandmarkHeuristic, for searches over an FNavGridFrozenGraph: locations are
+ * node numbers, so both the octile distance and the landmark tables are found by indexing rather than hashing.
+ *
+ * The landmark bound is only used if the tables have been reordered for the graph (see FNavGridLandmarks::ReorderFor).
+ * Holds pointers to the graph and the tables, which must outlive any search using it.
+ */
+struct FNavGridFrozenHeuristic
+{
+	FNavGridFrozenHeuristic() = default;
+	FNavGridFrozenHeuristic(const FNavGridFrozenGraph& NewGraph, const FNavGridLandmarks& NewLandmarks, const uint32 NewGoal)
+		: Graph(&NewGraph), Goal(NewGoal)
+	{
+		if (!NewLandmarks.IsEmpty() && NewLandmarks.IsOrderedFor(NewGraph) && NewGraph.HasNode(NewGoal)) {
+			Landmarks = &NewLandmarks;
+			GoalDistances = NewLandmarks.GetFrozenDistances(NewGoal);
+		}
+	}
+
+	FORCEINLINE double Estimate(const uint32 From, const uint32 To) const
+	{
+		const double Octile = GridNavigatorSearch::FOctileHeuristic2D::Estimate(Graph->GetNodeLocation(From), Graph->GetNodeLocation(To));
+		if (!Landmarks) {
+			return Octile;
+		}
+
+		const TConstArrayView<float> ToDistances = To == Goal ? GoalDistances : Landmarks->GetFrozenDistances(To);
+		return FMath::Max(Octile, FNavGridLandmarks::GetLowerBound(Landmarks->GetFrozenDistances(From), ToDistances));
+	}
+
+private:
+	const FNavGridFrozenGraph* Graph = nullptr;
+	const FNavGridLandmarks* Landmarks = nullptr;
+	uint32 Goal = FNavGridFrozenGraph::InvalidNode;
+	TConstArrayView<float> GoalDistances;
+};
@@ -4,6 +4,8 @@
 
 DECLARE_LOG_CATEGORY_CLASS(LogNavGridLevel, Log, All);
 
+using NavGrid::FAdjacencyListIndex;
+
 FString FNavGridLevel::ToString() const
 {
 	std::stringstream SStream;
@@ -20,6 +22,16 @@ FString FNavGridLevel::ToString() const
 	return Result;
 }
 
+FNavGridAdjacencyList::FNodeRange FNavGridLevel::GetBlockNodes(const uint32 ID) const
+{
+	const FNavGridBlock* Block = Blocks.Find(ID);
+	if (!Block) {
+		// a region with its corners swapped contains nothing, so the range ends where it starts
+		return Map.GetNodes({ FAdjacencyListIndex(0, 0, 0), FAdjacencyListIndex(-1, -1, -1) });
+	}
+	return Map.GetNodes(FNavGridAdjacencyList::FRegion::FromWorldBounds(Block->Bounds));
+}
+
 FBox FNavGridLevel::GetBounds() const
 {
 	const FVector MaxFloatVector = FVector(TNumericLimits<float>::Max());
@@ -35,3 +47,27 @@ FBox FNavGridLevel::GetBounds() const
 	}
 	return Result;
 }
+
+void FNavGridLevel::RebuildHierarchy()
+{
+	TArray<FBox> BlockBounds;
+	BlockBounds.Reserve(Blocks.Num());
+	for (const auto& [ID, Block] : Blocks) {
+		BlockBounds.Add(Block.Bounds);
+	}
+
+	Hierarchy.Clear();
+	Hierarchy.RebuildClusters(Map, BlockBounds);
+}
+
+void FNavGridLevel::UpdateHierarchy(const FNavGridHierarchy& PreviousHierarchy, TConstArrayView<FInt64Vector3> ChangedNodes)
+{
+	Hierarchy = PreviousHierarchy;
+	Hierarchy.UpdateClusters(Map, ChangedNodes);
+}
+
+void FNavGridLevel::FreezeGraph()
+{
+	Graph.Build(Map);
+	Landmarks.ReorderFor(Graph);
+}
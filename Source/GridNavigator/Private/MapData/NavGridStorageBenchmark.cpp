@@ -0,0 +1,151 @@
+#include "GridNavigatorConfig.h"
+#include "HAL/IConsoleManager.h"
+#include "MapData/NavGridAdjacencyList.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogNavGridStorageBenchmark, Log, All)
+
+using NavGrid::FAdjacencyListIndex;
+
+namespace
+{
+	// how FNavGridAdjacencyList stored its nodes before they were grouped into tiles: hashed by index, with every
+	// node owning separate arrays for its full, unpacked edges and its incoming neighbors
+	struct FHashedNode
+	{
+		FAdjacencyListIndex Index;
+		TArray<NavGrid::FEdge> OutEdges;
+		TArray<FAdjacencyListIndex> InNeighbors;
+	};
+	typedef TMap<FAdjacencyListIndex, FHashedNode> FHashedNodeMap;
+
+	// layers are stacked far enough apart that no two of them are ever joined
+	constexpr int64 LayerSpacing = 8;
+
+	/**
+	 * @brief Builds the same synthetic grid into both kinds of storage: NumLayers flat floors of Width x Width
+	 * cells, each cell joined to all eight of its neighbors.
+	 */
+	void BuildGrids(const int32 Width, const int32 NumLayers, FNavGridAdjacencyList& OutTiled, FHashedNodeMap& OutHashed)
+	{
+		for (int32 Layer = 0; Layer < NumLayers; ++Layer) {
+			for (int32 X = 0; X < Width; ++X) {
+				for (int32 Y = 0; Y < Width; ++Y) {
+					const FAdjacencyListIndex Index(X, Y, Layer * LayerSpacing);
+					OutTiled.AddNode(Index);
+					OutHashed.FindOrAdd(Index, { Index });
+
+					for (int32 Direction = 0; Direction < NavGrid::NumDirections; ++Direction) {
+						const FAdjacencyListIndex Neighbor(X + NavGrid::DirectionOffsetX[Direction], Y + NavGrid::DirectionOffsetY[Direction], Index.Z);
+						if (Neighbor.X < 0 || Neighbor.Y < 0 || Neighbor.X >= Width || Neighbor.Y >= Width) {
+							continue;
+						}
+
+						const float Height = Index.Z * GridNavigatorConfig::GridSizeZ;
+						const FVector EdgeDirection(Neighbor.X - Index.X, Neighbor.Y - Index.Y, 0.0);
+						OutTiled.CreateEdge(Index, Neighbor, NavGrid::Direct, Height);
+
+						OutHashed[Index].OutEdges.Emplace(Index, Neighbor, NavGrid::Direct, EdgeDirection, Height);
+						OutHashed.FindOrAdd(Neighbor, { Neighbor }).InNeighbors.Add(Index);
+					}
+				}
+			}
+		}
+		OutTiled.Compact();
+	}
+
+	SIZE_T GetHashedAllocatedSize(const FHashedNodeMap& Hashed)
+	{
+		SIZE_T Size = Hashed.GetAllocatedSize();
+		for (const auto& [Index, Node] : Hashed) {
+			Size += Node.OutEdges.GetAllocatedSize() + Node.InNeighbors.GetAllocatedSize();
+		}
+		return Size;
+	}
+
+	/**
+	 * @brief Times a callable over every query location, returning the time taken in milliseconds.
+	 */
+	template <typename CallableT>
+	double TimeQueries(const TArray<FAdjacencyListIndex>& Queries, CallableT&& Callable)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (const FAdjacencyListIndex& Query : Queries) {
+			Callable(Query);
+		}
+		return (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	}
+
+	void RunStorageBenchmark(const TArray<FString>& Args)
+	{
+		const int32 Width = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 512;
+		const int32 NumLayers = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 2;
+		const int32 NumLookups = Args.Num() > 2 ? FMath::Max(1, FCString::Atoi(*Args[2])) : 1000000;
+
+		FNavGridAdjacencyList Tiled;
+		FHashedNodeMap Hashed;
+		BuildGrids(Width, NumLayers, Tiled, Hashed);
+
+		// about a third of the lookups land on a node; the rest miss by falling between layers or off the grid
+		FRandomStream Random(Width * 31 + NumLayers);
+		TArray<FAdjacencyListIndex> Queries;
+		Queries.Reserve(NumLookups);
+		for (int32 Lookup = 0; Lookup < NumLookups; ++Lookup) {
+			const int64 X = Random.RandRange(-Width / 8, Width + Width / 8);
+			const int64 Y = Random.RandRange(-Width / 8, Width + Width / 8);
+			const int64 Z = Random.RandRange(0, NumLayers * 2 - 1) * LayerSpacing / 2;
+			Queries.Emplace(X, Y, Z);
+		}
+
+		int32 TiledHits = 0;
+		int32 HashedHits = 0;
+		const double TiledLookupMs = TimeQueries(Queries, [&](const FAdjacencyListIndex& Query)
+		{
+			TiledHits += Tiled.HasNode(Query) ? 1 : 0;
+		});
+		const double HashedLookupMs = TimeQueries(Queries, [&](const FAdjacencyListIndex& Query)
+		{
+			HashedHits += Hashed.Contains(Query) ? 1 : 0;
+		});
+
+		// the access pattern of a search expanding a node: find it, then visit each of its traversable edges
+		double TiledCost = 0.0;
+		double HashedCost = 0.0;
+		const double TiledNeighborsMs = TimeQueries(Queries, [&](const FAdjacencyListIndex& Query)
+		{
+			Tiled.ForEachReachableNeighbor(Query, [&TiledCost](const FAdjacencyListIndex&, const double EdgeCost)
+			{
+				TiledCost += EdgeCost;
+			});
+		});
+		const double HashedNeighborsMs = TimeQueries(Queries, [&](const FAdjacencyListIndex& Query)
+		{
+			if (const FHashedNode* Node = Hashed.Find(Query)) {
+				for (const NavGrid::FEdge& Edge : Node->OutEdges) {
+					if (NavGrid::IsTraversableEdgeType(Edge.Type)) {
+						HashedCost += Edge.Cost;
+					}
+				}
+			}
+		});
+
+		check(TiledHits == HashedHits);
+		check(FMath::IsNearlyEqual(TiledCost, HashedCost));
+
+		const SIZE_T TiledBytes = Tiled.GetAllocatedSize();
+		const SIZE_T HashedBytes = GetHashedAllocatedSize(Hashed);
+		const int32 NumNodes = Tiled.GetNumNodes();
+
+		UE_LOG(LogNavGridStorageBenchmark, Display, TEXT("%d x %d x %d grid, %d nodes, %d lookups (%d hits)"), Width, Width, NumLayers, NumNodes, NumLookups, TiledHits);
+		UE_LOG(LogNavGridStorageBenchmark, Display, TEXT("  Memory:    tiled %.1f MiB (%llu bytes per node), hashed %.1f MiB (%llu bytes per node)"),
+			TiledBytes / (1024.0 * 1024.0), static_cast<uint64>(TiledBytes / NumNodes), HashedBytes / (1024.0 * 1024.0), static_cast<uint64>(HashedBytes / NumNodes));
+		UE_LOG(LogNavGridStorageBenchmark, Display, TEXT("  HasNode:   tiled %.2f ms, hashed %.2f ms"), TiledLookupMs, HashedLookupMs);
+		UE_LOG(LogNavGridStorageBenchmark, Display, TEXT("  Neighbors: tiled %.2f ms, hashed %.2f ms"), TiledNeighborsMs, HashedNeighborsMs);
+	}
+
+	FAutoConsoleCommand BenchmarkStorageCommand(
+		TEXT("GridNavigator.BenchmarkStorage"),
+		TEXT("Compares the memory use and lookup speed of the navigation grid's tiled node storage against a hash map of nodes. ")
+		TEXT("Arguments: [Width=512] [Layers=2] [Lookups=1000000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunStorageBenchmark)
+	);
+}
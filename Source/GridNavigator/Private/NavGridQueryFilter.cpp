@@ -0,0 +1,67 @@
+#include "NavGridQueryFilter.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogNavGridQueryFilter, Log, All)
+
+namespace
+{
+	/**
+	 * @brief Filter that only identifies the grid filter type, since filter implementations are handed around
+	 * through their interface and RTTI is unavailable.
+	 *
+	 * Grid filters recognize it in IsEqual. FRecastQueryFilter::IsEqual compares whole objects, virtual table
+	 * included, so other implementations never report it as equal.
+	 */
+	const FNavGridQueryFilter& GetTypeTag()
+	{
+		static const FNavGridQueryFilter TypeTag;
+		return TypeTag;
+	}
+}
+
+INavigationQueryFilterInterface* FNavGridQueryFilter::CreateCopy() const
+{
+	return new FNavGridQueryFilter(*this);
+}
+
+bool FNavGridQueryFilter::IsEqual(const INavigationQueryFilterInterface* Other) const
+{
+	if (Other == &GetTypeTag()) {
+		return true;
+	}
+
+	const FNavGridQueryFilter* OtherGridFilter = Cast(Other);
+	return OtherGridFilter && FRecastQueryFilter::IsEqual(Other) && PathSmoothing == OtherGridFilter->PathSmoothing;
+}
+
+const FNavGridQueryFilter* FNavGridQueryFilter::Cast(const INavigationQueryFilterInterface* Implementation)
+{
+	if (Implementation == nullptr || !Implementation->IsEqual(&GetTypeTag())) {
+		return nullptr;
+	}
+	return static_cast<const FNavGridQueryFilter*>(Implementation);
+}
+
+FNavGridQueryFilter* FNavGridQueryFilter::Cast(INavigationQueryFilterInterface* Implementation)
+{
+	return const_cast<FNavGridQueryFilter*>(Cast(static_cast<const INavigationQueryFilterInterface*>(Implementation)));
+}
+
+EGridNavigatorPathSmoothing FNavGridQueryFilter::GetPathSmoothing(const FNavigationQueryFilter* Filter)
+{
+	const FNavGridQueryFilter* GridFilter = Filter ? Cast(Filter->GetImplementation()) : nullptr;
+	return GridFilter ? GridFilter->PathSmoothing : EGridNavigatorPathSmoothing::RemoveCollinear;
+}
+
+void UNavGridQueryFilter::InitializeFilter(const ANavigationData& NavData, const UObject* Querier, FNavigationQueryFilter& Filter) const
+{
+	Super::InitializeFilter(NavData, Querier, Filter);
+
+	// other navigation data copies its own filter implementation, which has nowhere to keep grid options
+	FNavGridQueryFilter* GridFilter = FNavGridQueryFilter::Cast(Filter.GetImplementation());
+	if (!GridFilter) {
+		return;
+	}
+
+	GridFilter->PathSmoothing = PathSmoothing;
+	UE_LOG(LogNavGridQueryFilter, Verbose, TEXT("Initialized grid query filter %s for %s"), *GetName(), *NavData.GetName());
+}
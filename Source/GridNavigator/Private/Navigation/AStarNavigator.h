@@ -1,14 +1,29 @@
 #pragma once
 
-#include <functional>
+#include "AStarSearchArena.h"
+#include "IndexedPriorityQueue.h"
 #include "PriorityQueue.h"
+#include "SearchPolicies.h"
 
 DECLARE_LOG_CATEGORY_CLASS(LogAStarNavigator, Log, All)
 
+/**
+ * @brief Stand-in for the callables that search templates pass to ForEachReachableNeighbor.
+ */
+template <typename LocationT>
+struct TNeighborVisitorArchetype
+{
+	void operator()(const LocationT& Neighbor, double EdgeCost) const {}
+};
+
+/**
+ * @brief A map that can be searched: it can report whether a node exists, and visit every neighbor reachable
+ * from a node in one step (along with the cost of the edge to it) without allocating.
+ */
 template <typename MapT, typename LocationT>
-concept can_query_nodes = requires(MapT Map, LocationT Index) {
+concept can_query_nodes = requires(MapT Map, LocationT Index, TNeighborVisitorArchetype<LocationT> Visitor) {
 	{ Map.HasNode(Index) } -> std::convertible_to<bool>;
-	{ Map.GetReachableNeighbors(Index) } -> std::convertible_to<TArray<LocationT>>;
+	Map.ForEachReachableNeighbor(Index, Visitor);
 };
 
 template <typename LocationT>
@@ -16,19 +31,232 @@ concept has_distance_metric = requires(const LocationT& Lhs, const LocationT& Rh
 	{ Distance(Lhs, Rhs) } -> std::floating_point;
 };
 
-template <typename MapT, typename LocationT>
-requires can_query_nodes<MapT, LocationT>
-class TAStarNavigator
+/**
+ * @brief A single, resumable A* search over any map that satisfies can_query_nodes.
+ *
+ * All of the search's state (open set, closed flags, costs and parents) lives in its arena, so the search can
+ * be advanced a few expansions at a time and picked up again later, eg. to spread a long query over several
+ * frames. The map must not change while a search over it is in progress.
+ *
+ * @tparam HeuristicT Heuristic policy (see SearchPolicies.h); must never overestimate the cost given by CostT
+ * @tparam CostT Edge cost policy (see SearchPolicies.h)
+ * @tparam OpenSetT Priority queue used for the open set. TIndexedPriorityQueue updates queued entries in
+ * place when a cheaper route is found; TPriorityQueue pushes duplicates and lets the search skip the stale
+ * ones. Both are kept so the two strategies can be benchmarked against each other.
+ */
+template <
+	typename MapT,
+	typename LocationT,
+	typename HeuristicT = GridNavigatorSearch::FOctileHeuristic2D,
+	typename CostT = GridNavigatorSearch::FStoredEdgeCost,
+	typename OpenSetT = TIndexedPriorityQueue<int32>>
+requires can_query_nodes<MapT, LocationT> && is_heuristic_policy<HeuristicT, LocationT> && is_edge_cost_policy<CostT, LocationT>
+class TAStarSearch
 {
-	struct FAStarNode
+public:
+	typedef TAStarSearchArena<LocationT, OpenSetT> FSearchArena;
+
+	enum class EStatus : uint8
 	{
-		FAStarNode* PrevNode;
-		LocationT Location;
-		double GCost;
+		InProgress,
+		Succeeded,
+		Failed,
 	};
 
+	/**
+	 * @brief Starts a search that keeps its state in an arena of its own, so that it can outlive the current frame.
+	 */
+	TAStarSearch(const MapT& NewMap, const LocationT& NewStartLocation, const LocationT& NewFinalLocation)
+		: OwnedArena(MakeUnique<FSearchArena>())
+	{
+		Start(NewMap, NewStartLocation, NewFinalLocation, *OwnedArena);
+	}
+
+	/**
+	 * @brief Starts a search that keeps its state in a caller-provided arena, which is reset first.
+	 */
+	TAStarSearch(const MapT& NewMap, const LocationT& NewStartLocation, const LocationT& NewFinalLocation, FSearchArena& NewArena)
+	{
+		Start(NewMap, NewStartLocation, NewFinalLocation, NewArena);
+	}
+
+	TAStarSearch(const TAStarSearch&) = delete;
+	TAStarSearch& operator=(const TAStarSearch&) = delete;
+
+	/**
+	 * @brief Advances the search by up to a fixed number of node expansions.
+	 *
+	 * @param MaxExpansions Upper bound on the number of nodes to expand before returning
+	 * @return The status of the search after this step
+	 */
+	EStatus Step(const int32 MaxExpansions)
+	{
+		const int32 TargetExpansions = NumExpansions + FMath::Min(MaxExpansions, MAX_int32 - NumExpansions);
+		while (Status == EStatus::InProgress && NumExpansions < TargetExpansions) {
+			ExpandNext();
+		}
+		return Status;
+	}
+
+	/**
+	 * @brief Advances the search until it finishes or a time budget runs out.
+	 *
+	 * @param TimeBudget Wall-clock time the step may take; checked every few expansions, so it may be exceeded slightly
+	 * @return The status of the search after this step
+	 */
+	EStatus Step(const FTimespan& TimeBudget)
+	{
+		constexpr int32 ExpansionsPerClockCheck = 32;
+
+		const double EndTime = FPlatformTime::Seconds() + TimeBudget.GetTotalSeconds();
+		do {
+			Step(ExpansionsPerClockCheck);
+		} while (Status == EStatus::InProgress && FPlatformTime::Seconds() < EndTime);
+		return Status;
+	}
+
+	/**
+	 * @brief Limits the search to paths that cost at most CostLimit; should be set before the first step.
+	 *
+	 * Nodes that cannot lie on a path within the limit (going by their cost so far plus the heuristic) are never
+	 * queued, so a search for an out-of-range goal stops early instead of flooding the map.
+	 */
+	FORCEINLINE void SetCostLimit(const double NewCostLimit) { CostLimit = NewCostLimit; }
+
+	/**
+	 * @brief Replaces the heuristic instance used to order the search; should be set before the first step.
+	 * Only needed for heuristics that carry data of their own, such as precomputed landmark distances.
+	 */
+	FORCEINLINE void SetHeuristic(const HeuristicT& NewHeuristic) { Heuristic = NewHeuristic; }
+
+	FORCEINLINE EStatus GetStatus() const { return Status; }
+	FORCEINLINE int32 GetNumExpansions() const { return NumExpansions; }
+
+	/**
+	 * @return The path from the start location to the final location, or an empty array if the search has
+	 * not succeeded
+	 */
+	TArray<LocationT> GetPath() const
+	{
+		TArray<LocationT> Result;
+		if (Status != EStatus::Succeeded) {
+			return Result;
+		}
+		for (int32 CurrSlot = FinalSlot; CurrSlot != INDEX_NONE; CurrSlot = (*Arena)[CurrSlot].ParentSlot) {
+			Result.Push((*Arena)[CurrSlot].Location);
+		}
+		Algo::Reverse(Result);
+		return Result;
+	}
+
+private:
+	void Start(const MapT& NewMap, const LocationT& NewStartLocation, const LocationT& NewFinalLocation, FSearchArena& NewArena)
+	{
+		Map = &NewMap;
+		FinalLocation = NewFinalLocation;
+		Arena = &NewArena;
+		Arena->Reset();
+
+		bool bWasAdded = false;
+		const int32 StartSlot = Arena->FindOrAdd(NewStartLocation, bWasAdded);
+		(*Arena)[StartSlot].GCost = 0.0;
+		Arena->OpenSet.Push(StartSlot, 0.0);
+	}
+
+	void ExpandNext()
+	{
+		auto& OpenSet = Arena->OpenSet;
+		if (OpenSet.IsEmpty()) {
+			Status = EStatus::Failed;
+			INC_DWORD_STAT_BY(STAT_GridNavigator_NodesExpanded, NumExpansions);
+			return;
+		}
+
+		const int32 CurrSlot = OpenSet.Pop();
+		check(CurrSlot != INDEX_NONE);
+
+		// skip stale duplicate entries for nodes that have already been expanded at their best cost
+		if ((*Arena)[CurrSlot].bClosed) {
+			return;
+		}
+		(*Arena)[CurrSlot].bClosed = true;
+		++NumExpansions;
+
+		// copy out of the arena, since adding neighbor records below may reallocate it
+		const LocationT CurrLocation = (*Arena)[CurrSlot].Location;
+		const double CurrCost = (*Arena)[CurrSlot].GCost;
+
+		if (CurrLocation == FinalLocation) {
+			Status = EStatus::Succeeded;
+			FinalSlot = CurrSlot;
+			INC_DWORD_STAT_BY(STAT_GridNavigator_NodesExpanded, NumExpansions);
+			return;
+		}
+
+		if (!Map->HasNode(CurrLocation)) {
+			return;
+		}
+
+		bool bWasAdded = false;
+		Map->ForEachReachableNeighbor(CurrLocation, [&](const LocationT& NeighborLocation, const double EdgeCost)
+		{
+			const double NeighborCost = CurrCost + CostT::GetCost(CurrLocation, NeighborLocation, EdgeCost);
+
+			const int32 NeighborSlot = Arena->FindOrAdd(NeighborLocation, bWasAdded);
+			auto& NeighborRecord = (*Arena)[NeighborSlot];
+
+			if (NeighborCost < NeighborRecord.GCost) {
+				const double Priority = NeighborCost + Heuristic.Estimate(NeighborLocation, FinalLocation);
+				if (Priority > CostLimit) {
+					return;
+				}
+
+				NeighborRecord.ParentSlot = CurrSlot;
+				NeighborRecord.GCost = NeighborCost;
+				NeighborRecord.bClosed = false;
+				OpenSet.Push(NeighborSlot, Priority);
+			}
+		});
+	}
+
+	const MapT* Map = nullptr;
+	LocationT FinalLocation;
+	double CostLimit = TNumericLimits<double>::Max();
+	HeuristicT Heuristic;
+	FSearchArena* Arena = nullptr;
+	TUniquePtr<FSearchArena> OwnedArena;
+
+	EStatus Status = EStatus::InProgress;
+	int32 FinalSlot = INDEX_NONE;
+	int32 NumExpansions = 0;
+};
+
+/**
+ * @brief A* search over any map that satisfies can_query_nodes, run to completion in a single call.
+ *
+ * @see TAStarSearch for the template parameters, and for searches that need to be spread over several calls
+ */
+template <
+	typename MapT,
+	typename LocationT,
+	typename HeuristicT = GridNavigatorSearch::FOctileHeuristic2D,
+	typename CostT = GridNavigatorSearch::FStoredEdgeCost,
+	typename OpenSetT = TIndexedPriorityQueue<int32>>
+requires can_query_nodes<MapT, LocationT> && is_heuristic_policy<HeuristicT, LocationT> && is_edge_cost_policy<CostT, LocationT>
+class TAStarNavigator
+{
 public:
-	std::function<double(const LocationT& Lhs, const LocationT& Rhs)> Heuristic;
+	typedef TAStarSearch<MapT, LocationT, HeuristicT, CostT, OpenSetT> FSearch;
+	typedef typename FSearch::FSearchArena FSearchArena;
+
+	// number of nodes expanded by the most recent search
+	int32 NumExpansions = 0;
+
+	// paths that cost more than this are not searched for; see TAStarSearch::SetCostLimit
+	double CostLimit = TNumericLimits<double>::Max();
+
+	// heuristic instance handed to each search; see TAStarSearch::SetHeuristic
+	HeuristicT Heuristic;
 
 	/**
 	 * @brief Performs A* navigation between two points on a provided map.
@@ -37,76 +265,35 @@ public:
 	 * @tparam LocationT The type representing locations within the map 
 	 * 
 	 * @param Map The map on which navigation is performed. The map type must support checking whether a
-	 * particular node is present in the map, and fetching all neighbors that are reachable from that node
+	 * particular node is present in the map, and visiting all neighbors that are reachable from that node
 	 * within the map.
 	 * @param StartLocation The starting location for pathfinding. 
 	 * @param FinalLocation The target location for pathfinding.
 	 * 
 	 * @return An array of location values that make up a path from StartLocation to FinalLocation in Map.
 	 *
-	 * @pre The `Heuristic` parameter must be set before calling this function. This function determines
-	 * the cost to travel between two locations and must be an admissible heuristic for A* to work.
+	 * @note Search state is kept in the calling thread's TAStarSearchArena, so a search performs no heap
+	 * allocations of its own once the arena has grown to fit it (the returned path is still allocated).
 	 */
 	TArray<LocationT> Navigate(const MapT& Map, const LocationT& StartLocation, const LocationT& FinalLocation)
 	{
-		TPriorityQueue<FAStarNode*> OpenSet;
-		TMap<LocationT, double> CostSoFar;
-		TArray<FAStarNode*> NodesToFree;
-		
-		FAStarNode* FromAStarNode = new FAStarNode({ nullptr, StartLocation, 0.0 });
-		NodesToFree.Push(FromAStarNode);
-		OpenSet.Push(FromAStarNode, 0);
-		CostSoFar.Add(StartLocation, 0.0);
-		
-		FAStarNode* CurrNodePtr = nullptr;
-		bool IsNavigationSuccessful = false;
-		while (!OpenSet.IsEmpty()) {
-			CurrNodePtr = OpenSet.Pop();
-			const auto [PrevNodePtr, CurrLocation, CurrCost] = *CurrNodePtr;
-
-			check(CurrNodePtr != nullptr);
-		
-			if (CurrLocation == FinalLocation) {
-				IsNavigationSuccessful = true;
-				break;
-			}
-
-			if (!Map.HasNode(CurrLocation.X, CurrLocation.Y, CurrLocation.Z)) {
-				continue;
-			}
-			
-			const auto& Neighbors = Map.GetReachableNeighbors(CurrLocation);
-
-			for (const auto& NeighborLocation : Neighbors) {
-				const double NeighborCost = CurrCost + Distance(CurrLocation, NeighborLocation);
-
-				if (!CostSoFar.Contains(NeighborLocation) || NeighborCost < CostSoFar[NeighborLocation]) {
-					FAStarNode* NeighborAStarNode = new FAStarNode({ CurrNodePtr, NeighborLocation, NeighborCost });
-					NodesToFree.Push(NeighborAStarNode);
-
-					CostSoFar.Add(NeighborLocation, NeighborCost);
-					const double Priority    = NeighborCost + Heuristic(NeighborLocation, FinalLocation);
-					NeighborAStarNode->GCost = NeighborCost;
-					OpenSet.Push(NeighborAStarNode, Priority);
-				}
-			}
-		}
-
-		TArray<LocationT> Result;
-		if (IsNavigationSuccessful) {
-			while (CurrNodePtr != nullptr) {
-				const auto [PrevNodePtr, CurrLocation, CurrCost] = *CurrNodePtr;
-				const LocationT NewPathNode(CurrLocation.X, CurrLocation.Y, CurrLocation.Z);
-				Result.Push(NewPathNode);
-				CurrNodePtr = CurrNodePtr->PrevNode;
-			}
-			Algo::Reverse(Result);
-		}
-
-		for (const FAStarNode* NodePtr : NodesToFree) {
-			delete NodePtr;
-		}
+		return Navigate(Map, StartLocation, FinalLocation, FSearchArena::Get());
+	}
 
-		return Result;
+	/**
+	 * @brief Performs A* navigation between two points on a provided map, using caller-provided search storage.
+	 *
+	 * @param Arena Storage for the search's node records and open set; reset at the start of the search
+	 *
+	 * @see Navigate(const MapT&, const LocationT&, const LocationT&)
+	 */
+	TArray<LocationT> Navigate(const MapT& Map, const LocationT& StartLocation, const LocationT& FinalLocation, FSearchArena& Arena)
+	{
+		FSearch Search(Map, StartLocation, FinalLocation, Arena);
+		Search.SetCostLimit(CostLimit);
+		Search.SetHeuristic(Heuristic);
+		Search.Step(MAX_int32);
+		NumExpansions = Search.GetNumExpansions();
+		return Search.GetPath();
 	}
 };
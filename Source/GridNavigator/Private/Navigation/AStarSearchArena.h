@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+
+#include "GridNavigatorStats.h"
+
+/**
+ * @brief Reusable storage for the transient state of a single A* search.
+ *
+ * Node records live in one dense array and are addressed by slot index; a location-to-slot lookup maps
+ * graph locations onto those slots. Both containers are reset (not freed) between searches, so once an
+ * arena has grown to fit the largest query it has seen, further queries perform no heap allocations.
+ *
+ * Locations that are integers (node numbers of a graph such as FNavGridFrozenGraph) are looked up in a plain
+ * array indexed by the location rather than a hash map; only the entries a search touched are cleared again.
+ *
+ * @tparam LocationT The type representing locations within the searched map
+ * @tparam OpenSetT The priority queue type used for the open set, keyed by slot index
+ */
+template <typename LocationT, typename OpenSetT>
+class TAStarSearchArena
+{
+public:
+	struct FNodeRecord
+	{
+		LocationT Location;
+		int32 ParentSlot;
+		double GCost;
+		bool bClosed;
+	};
+
+	/**
+	 * @brief Returns the arena owned by the calling thread.
+	 *
+	 * @note The returned arena is shared by every search on the thread, so searches must not be nested.
+	 */
+	static TAStarSearchArena& Get()
+	{
+		static thread_local TAStarSearchArena ThreadArena;
+		return ThreadArena;
+	}
+
+	/**
+	 * @brief Clears all search state while keeping the underlying allocations for the next search.
+	 */
+	void Reset()
+	{
+		UpdatePeakStats();
+
+		if constexpr (bHasDenseLocations) {
+			for (const FNodeRecord& Record : Records) {
+				DenseSlots[Record.Location] = INDEX_NONE;
+			}
+		}
+		Records.Reset();
+		SlotLookup.Reset();
+		OpenSet.Reset();
+	}
+
+	/**
+	 * @brief Looks up the slot assigned to a location, or allocates a new one.
+	 *
+	 * @param Location The location to look up
+	 * @param bOutWasAdded Set to \c true if a new record was created for Location; \c false otherwise
+	 * @return Slot index of the record for Location
+	 *
+	 * @note Newly added records have no parent and an infinite cost.
+	 */
+	int32 FindOrAdd(const LocationT& Location, bool& bOutWasAdded)
+	{
+		if constexpr (bHasDenseLocations) {
+			if (static_cast<int64>(Location) >= DenseSlots.Num()) {
+				const int32 OldNum = DenseSlots.Num();
+				DenseSlots.SetNumUninitialized(static_cast<int32>(Location) + 1);
+				for (int32 Index = OldNum; Index < DenseSlots.Num(); ++Index) {
+					DenseSlots[Index] = INDEX_NONE;
+				}
+			}
+
+			int32& DenseSlot = DenseSlots[Location];
+			bOutWasAdded = DenseSlot == INDEX_NONE;
+			if (bOutWasAdded) {
+				DenseSlot = Records.Add({ Location, INDEX_NONE, TNumericLimits<double>::Max(), false });
+			}
+			return DenseSlot;
+		}
+		else {
+			const uint32 LocationHash = GetTypeHash(Location);
+			if (const int32* ExistingSlot = SlotLookup.FindByHash(LocationHash, Location)) {
+				bOutWasAdded = false;
+				return *ExistingSlot;
+			}
+
+			const int32 NewSlot = Records.Add({ Location, INDEX_NONE, TNumericLimits<double>::Max(), false });
+			SlotLookup.AddByHash(LocationHash, Location, NewSlot);
+			bOutWasAdded = true;
+			return NewSlot;
+		}
+	}
+
+	/**
+	 * @return Slot index of the record for Location, or INDEX_NONE if the location has not been visited
+	 */
+	int32 Find(const LocationT& Location) const
+	{
+		if constexpr (bHasDenseLocations) {
+			return static_cast<int64>(Location) < DenseSlots.Num() ? DenseSlots[Location] : INDEX_NONE;
+		}
+		else {
+			const int32* ExistingSlot = SlotLookup.Find(Location);
+			return ExistingSlot ? *ExistingSlot : INDEX_NONE;
+		}
+	}
+
+	FORCEINLINE FNodeRecord& operator[](const int32 Slot) { return Records[Slot]; }
+	FORCEINLINE const FNodeRecord& operator[](const int32 Slot) const { return Records[Slot]; }
+	FORCEINLINE int32 Num() const { return Records.Num(); }
+
+	/**
+	 * @return The number of bytes currently reserved by this arena
+	 */
+	SIZE_T GetAllocatedSize() const
+	{
+		return Records.GetAllocatedSize() + SlotLookup.GetAllocatedSize() + DenseSlots.GetAllocatedSize() + OpenSet.GetAllocatedSize();
+	}
+
+	OpenSetT OpenSet;
+
+private:
+	static constexpr bool bHasDenseLocations = std::is_integral_v<LocationT> && std::is_unsigned_v<LocationT>;
+
+	void UpdatePeakStats()
+	{
+		const uint32 NumRecords = static_cast<uint32>(Records.Num());
+		uint32 PrevPeakNodes = PeakNodes.load(std::memory_order_relaxed);
+		while (NumRecords > PrevPeakNodes && !PeakNodes.compare_exchange_weak(PrevPeakNodes, NumRecords, std::memory_order_relaxed)) {}
+
+		const SIZE_T AllocatedSize = GetAllocatedSize();
+		SIZE_T PrevPeakMemory = PeakMemory.load(std::memory_order_relaxed);
+		while (AllocatedSize > PrevPeakMemory && !PeakMemory.compare_exchange_weak(PrevPeakMemory, AllocatedSize, std::memory_order_relaxed)) {}
+
+		SET_DWORD_STAT(STAT_GridNavigator_ArenaPeakNodes, PeakNodes.load(std::memory_order_relaxed));
+		SET_MEMORY_STAT(STAT_GridNavigator_ArenaPeakMemory, PeakMemory.load(std::memory_order_relaxed));
+	}
+
+	TArray<FNodeRecord> Records;
+	TMap<LocationT, int32> SlotLookup;
+
+	// slot of every location visited by the current search, indexed by the location itself; unused unless bHasDenseLocations
+	TArray<int32> DenseSlots;
+
+	// high-water marks across every arena of this type, on all threads
+	static inline std::atomic<uint32> PeakNodes = 0;
+	static inline std::atomic<SIZE_T> PeakMemory = 0;
+};
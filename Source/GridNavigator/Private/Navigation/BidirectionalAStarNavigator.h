@@ -0,0 +1,200 @@
+#pragma once
+
+#include "AStarNavigator.h"
+
+/**
+ * @brief Bidirectional A* search: expands from the start over the map and from the goal over a reversed
+ * view of the map until the two searches meet.
+ *
+ * Each step expands whichever side has the smaller open set. Every time either side lowers the cost of a
+ * location the other side has already reached, the joined path becomes a candidate, and the search stops
+ * once the lowest f-cost left on either side can no longer improve on the best candidate. Because either
+ * side running out of nodes proves that no better route exists, queries towards an unreachable or poorly
+ * connected goal finish as soon as the smaller of the two regions has been flooded.
+ *
+ * @tparam MapT Map searched forwards, from the start location
+ * @tparam ReverseMapT Map whose neighbors are the nodes that can reach a location in MapT (eg. FNavGridReverseAdjacencyView)
+ * @tparam HeuristicT Heuristic policy (see SearchPolicies.h); must be symmetric, consistent and admissible
+ * so that both searches agree on the cost of the paths they find
+ * @tparam CostT Edge cost policy (see SearchPolicies.h); must give an edge the same cost in both directions
+ * @tparam OpenSetT Priority queue used for both open sets; see TAStarNavigator
+ */
+template <
+	typename MapT,
+	typename ReverseMapT,
+	typename LocationT,
+	typename HeuristicT = GridNavigatorSearch::FOctileHeuristic2D,
+	typename CostT = GridNavigatorSearch::FStoredEdgeCost,
+	typename OpenSetT = TIndexedPriorityQueue<int32>>
+requires can_query_nodes<MapT, LocationT> && can_query_nodes<ReverseMapT, LocationT>
+	&& is_heuristic_policy<HeuristicT, LocationT> && is_edge_cost_policy<CostT, LocationT>
+class TBidirectionalAStarNavigator
+{
+public:
+	typedef TAStarSearchArena<LocationT, OpenSetT> FSearchArena;
+
+	// number of nodes expanded by the most recent search, across both directions
+	int32 NumExpansions = 0;
+
+	// locations whose f-cost is above this are never opened on either side, so paths that cost more are not found
+	double CostLimit = TNumericLimits<double>::Max();
+
+	/**
+	 * @brief Performs bidirectional A* navigation between two points on a provided map.
+	 *
+	 * @param Map The map on which navigation is performed
+	 * @param ReverseMap The same map with every edge reversed
+	 * @param StartLocation The starting location for pathfinding
+	 * @param FinalLocation The target location for pathfinding
+	 *
+	 * @return An array of location values that make up a path from StartLocation to FinalLocation in Map,
+	 * or an empty array if there is no such path.
+	 */
+	TArray<LocationT> Navigate(const MapT& Map, const ReverseMapT& ReverseMap, const LocationT& StartLocation, const LocationT& FinalLocation)
+	{
+		return Navigate(Map, ReverseMap, StartLocation, FinalLocation, FSearchArena::Get(), GetReverseArena());
+	}
+
+	/**
+	 * @brief Performs bidirectional A* navigation using caller-provided search storage.
+	 *
+	 * @param ForwardArena Storage for the search from the start; reset at the start of the search
+	 * @param ReverseArena Storage for the search from the goal; reset at the start of the search
+	 *
+	 * @see Navigate(const MapT&, const ReverseMapT&, const LocationT&, const LocationT&)
+	 */
+	TArray<LocationT> Navigate(const MapT& Map, const ReverseMapT& ReverseMap, const LocationT& StartLocation, const LocationT& FinalLocation, FSearchArena& ForwardArena, FSearchArena& ReverseArena)
+	{
+		check(&ForwardArena != &ReverseArena);
+
+		ForwardArena.Reset();
+		ReverseArena.Reset();
+		NumExpansions = 0;
+
+		if (!Map.HasNode(StartLocation) || !Map.HasNode(FinalLocation)) {
+			return {};
+		}
+		if (StartLocation == FinalLocation) {
+			return { StartLocation };
+		}
+
+		bool bWasAdded = false;
+		const int32 StartSlot = ForwardArena.FindOrAdd(StartLocation, bWasAdded);
+		ForwardArena[StartSlot].GCost = 0.0;
+		ForwardArena.OpenSet.Push(StartSlot, HeuristicT::Estimate(StartLocation, FinalLocation));
+
+		const int32 FinalSlot = ReverseArena.FindOrAdd(FinalLocation, bWasAdded);
+		ReverseArena[FinalSlot].GCost = 0.0;
+		ReverseArena.OpenSet.Push(FinalSlot, HeuristicT::Estimate(FinalLocation, StartLocation));
+
+		FMeetingPoint BestMeeting;
+		while (!ForwardArena.OpenSet.IsEmpty() && !ReverseArena.OpenSet.IsEmpty()) {
+			// neither side can find anything cheaper than the best path found so far
+			const double ForwardBound = ForwardArena.OpenSet.GetMinPriority();
+			const double ReverseBound = ReverseArena.OpenSet.GetMinPriority();
+			if (FMath::Max(ForwardBound, ReverseBound) >= BestMeeting.Cost) {
+				break;
+			}
+
+			if (ForwardArena.OpenSet.Num() <= ReverseArena.OpenSet.Num()) {
+				ExpandNext(Map, ForwardArena, ReverseArena, FinalLocation, BestMeeting);
+			}
+			else {
+				ExpandNext(ReverseMap, ReverseArena, ForwardArena, StartLocation, BestMeeting);
+			}
+		}
+
+		INC_DWORD_STAT_BY(STAT_GridNavigator_NodesExpanded, NumExpansions);
+
+		TArray<LocationT> Result;
+		if (BestMeeting.Location.IsSet()) {
+			const LocationT& MeetingLocation = BestMeeting.Location.GetValue();
+
+			for (int32 CurrSlot = ForwardArena.Find(MeetingLocation); CurrSlot != INDEX_NONE; CurrSlot = ForwardArena[CurrSlot].ParentSlot) {
+				Result.Push(ForwardArena[CurrSlot].Location);
+			}
+			Algo::Reverse(Result);
+
+			// parents in the reverse search point towards the goal
+			for (int32 CurrSlot = ReverseArena[ReverseArena.Find(MeetingLocation)].ParentSlot; CurrSlot != INDEX_NONE; CurrSlot = ReverseArena[CurrSlot].ParentSlot) {
+				Result.Push(ReverseArena[CurrSlot].Location);
+			}
+		}
+
+		return Result;
+	}
+
+private:
+	struct FMeetingPoint
+	{
+		TOptional<LocationT> Location;
+		double Cost = TNumericLimits<double>::Max();
+	};
+
+	static FSearchArena& GetReverseArena()
+	{
+		static thread_local FSearchArena ThreadArena;
+		return ThreadArena;
+	}
+
+	/**
+	 * @brief Expands the best open node of one side of the search.
+	 *
+	 * @param SearchedMap The map as seen by the expanding side
+	 * @param Arena The expanding side's search state
+	 * @param OtherArena The opposite side's search state, checked for meeting points
+	 * @param TargetLocation The location the expanding side is searching towards
+	 * @param BestMeeting Updated whenever a cheaper joined path is found
+	 */
+	template <typename SearchedMapT>
+	void ExpandNext(const SearchedMapT& SearchedMap, FSearchArena& Arena, const FSearchArena& OtherArena, const LocationT& TargetLocation, FMeetingPoint& BestMeeting)
+	{
+		const int32 CurrSlot = Arena.OpenSet.Pop();
+		if (Arena[CurrSlot].bClosed) {
+			return;
+		}
+		Arena[CurrSlot].bClosed = true;
+		++NumExpansions;
+
+		// copy out of the arena, since adding neighbor records below may reallocate it
+		const LocationT CurrLocation = Arena[CurrSlot].Location;
+		const double CurrCost = Arena[CurrSlot].GCost;
+
+		if (!SearchedMap.HasNode(CurrLocation)) {
+			return;
+		}
+
+		bool bWasAdded = false;
+		SearchedMap.ForEachReachableNeighbor(CurrLocation, [&](const LocationT& NeighborLocation, const double EdgeCost)
+		{
+			const double NeighborCost = CurrCost + CostT::GetCost(CurrLocation, NeighborLocation, EdgeCost);
+			const double Priority = NeighborCost + HeuristicT::Estimate(NeighborLocation, TargetLocation);
+
+			// the heuristic never overestimates, so any path joined through this neighbor costs at least this much
+			if (Priority > CostLimit) {
+				return;
+			}
+
+			const int32 NeighborSlot = Arena.FindOrAdd(NeighborLocation, bWasAdded);
+			auto& NeighborRecord = Arena[NeighborSlot];
+			if (NeighborCost >= NeighborRecord.GCost) {
+				return;
+			}
+
+			NeighborRecord.ParentSlot = CurrSlot;
+			NeighborRecord.GCost = NeighborCost;
+			NeighborRecord.bClosed = false;
+			Arena.OpenSet.Push(NeighborSlot, Priority);
+
+			const int32 OtherSlot = OtherArena.Find(NeighborLocation);
+			if (OtherSlot == INDEX_NONE) {
+				return;
+			}
+			const double JoinedCost = NeighborCost + OtherArena[OtherSlot].GCost;
+			if (JoinedCost < BestMeeting.Cost && JoinedCost <= CostLimit) {
+				BestMeeting.Location = NeighborLocation;
+				BestMeeting.Cost = JoinedCost;
+			}
+		});
+	}
+};
@@ -0,0 +1,305 @@
+#pragma once
+
+#include "AStarNavigator.h"
+
+/**
+ * @brief Priority of a node in a D* Lite search, compared lexicographically.
+ */
+struct FDStarLiteKey
+{
+	double Primary;
+	double Secondary;
+
+	FORCEINLINE bool operator<(const FDStarLiteKey& Rhs) const
+	{
+		return Primary < Rhs.Primary || (Primary == Rhs.Primary && Secondary < Rhs.Secondary);
+	}
+};
+
+/**
+ * @brief Incremental shortest path search (D* Lite) for an agent moving towards a fixed goal over a changing map.
+ *
+ * The search runs backwards from the goal, so its state stays valid as the agent moves: moving the start only
+ * shifts the heuristic, and a change to the map only invalidates the costs of the nodes around the change.
+ * Replanning then repairs just the part of the search tree that the change affects, instead of searching
+ * again from scratch.
+ *
+ * The planner keeps references to both maps, which must outlive it. The maps may be edited, or swapped for
+ * other versions through SetMaps, between calls to Plan, as long as every node whose outgoing edges changed is
+ * reported through NotifyNodesChanged first.
+ *
+ * @tparam MapT The map to plan over
+ * @tparam ReverseMapT A view of MapT with every edge reversed (eg. FNavGridReverseAdjacencyView)
+ * @tparam HeuristicT Heuristic policy (see SearchPolicies.h); must be consistent for the costs given by CostT
+ * @tparam CostT Edge cost policy (see SearchPolicies.h)
+ */
+template <
+	typename MapT,
+	typename ReverseMapT,
+	typename LocationT,
+	typename HeuristicT = GridNavigatorSearch::FOctileHeuristic2D,
+	typename CostT = GridNavigatorSearch::FStoredEdgeCost>
+requires can_query_nodes<MapT, LocationT> && can_query_nodes<ReverseMapT, LocationT>
+	&& is_heuristic_policy<HeuristicT, LocationT> && is_edge_cost_policy<CostT, LocationT>
+class TDStarLitePlanner
+{
+public:
+	TDStarLitePlanner(const MapT& NewMap, const ReverseMapT& NewReverseMap, const LocationT& NewStart, const LocationT& NewGoal)
+		: Map(&NewMap), ReverseMap(NewReverseMap), Start(NewStart), Goal(NewGoal)
+	{
+		const int32 GoalSlot = FindOrAddSlot(Goal);
+		States[GoalSlot].Rhs = 0.0;
+		OpenSet.Push(GoalSlot, CalculateKey(GoalSlot));
+	}
+
+	/**
+	 * @brief Brings the search up to date with the current start and map.
+	 *
+	 * @return \c true if the goal can be reached from the start; \c false otherwise
+	 */
+	bool Plan()
+	{
+		NumExpansions = 0;
+		const int32 StartSlot = FindOrAddSlot(Start);
+
+		while (!OpenSet.IsEmpty() && (!IsSettledBefore(CalculateKey(StartSlot), OpenSet.GetMinPriority()) || States[StartSlot].Rhs != States[StartSlot].G)) {
+			const int32 CurrSlot = OpenSet.Top();
+			const FDStarLiteKey OldKey = OpenSet.GetMinPriority();
+			const FDStarLiteKey NewKey = CalculateKey(CurrSlot);
+			++NumExpansions;
+
+			if (OldKey < NewKey) {
+				OpenSet.Update(CurrSlot, NewKey);
+				continue;
+			}
+
+			// copy out of the state array, since visiting neighbors below may add states and reallocate it
+			const LocationT CurrLocation = States[CurrSlot].Location;
+
+			if (States[CurrSlot].G > States[CurrSlot].Rhs) {
+				// overconsistent: the node got cheaper, so settle it and offer the new cost to its predecessors
+				States[CurrSlot].G = States[CurrSlot].Rhs;
+				OpenSet.Remove(CurrSlot);
+
+				const double CurrCost = States[CurrSlot].G;
+				ReverseMap.ForEachReachableNeighbor(CurrLocation, [&](const LocationT& PredLocation, const double EdgeCost)
+				{
+					const int32 PredSlot = FindOrAddSlot(PredLocation);
+					if (PredLocation != Goal) {
+						const double ViaCurr = CostT::GetCost(PredLocation, CurrLocation, EdgeCost) + CurrCost;
+						States[PredSlot].Rhs = FMath::Min(States[PredSlot].Rhs, ViaCurr);
+					}
+					UpdateState(PredSlot);
+				});
+			}
+			else {
+				// underconsistent: the node got more expensive, so reset it and let everything that relied on it
+				// look for another route
+				const double OldCost = States[CurrSlot].G;
+				States[CurrSlot].G = Infinity;
+
+				ReverseMap.ForEachReachableNeighbor(CurrLocation, [&](const LocationT& PredLocation, const double EdgeCost)
+				{
+					const int32 PredSlot = FindOrAddSlot(PredLocation);
+					if (PredLocation != Goal && States[PredSlot].Rhs == CostT::GetCost(PredLocation, CurrLocation, EdgeCost) + OldCost) {
+						States[PredSlot].Rhs = GetBestSuccessorCost(PredLocation);
+					}
+					UpdateState(PredSlot);
+				});
+
+				if (CurrLocation != Goal) {
+					States[CurrSlot].Rhs = GetBestSuccessorCost(CurrLocation);
+				}
+				UpdateState(CurrSlot);
+			}
+		}
+
+		INC_DWORD_STAT_BY(STAT_GridNavigator_NodesExpanded, NumExpansions);
+		return States[StartSlot].G < Infinity;
+	}
+
+	/**
+	 * @brief Moves the start of the search, eg. as the agent advances along its path. Takes effect on the next Plan.
+	 */
+	void SetStart(const LocationT& NewStart)
+	{
+		// queued keys were computed relative to the previous start; shifting every future key by the distance moved
+		// keeps the queued ones valid lower bounds without requeueing the whole open set
+		KeyModifier += HeuristicT::Estimate(Start, NewStart);
+		Start = NewStart;
+	}
+
+	/**
+	 * @brief Moves the search onto another version of the map, eg. a newly built snapshot of it. The nodes that
+	 * differ between the two versions must then be reported through NotifyNodesChanged before the next Plan.
+	 */
+	void SetMaps(const MapT& NewMap, const ReverseMapT& NewReverseMap)
+	{
+		Map = &NewMap;
+		ReverseMap = NewReverseMap;
+	}
+
+	/**
+	 * @brief Reports nodes whose outgoing edges were added, removed or changed, including nodes that were
+	 * added to or removed from the map. Takes effect on the next Plan.
+	 *
+	 * @param ChangedNodes Every node whose set of traversable outgoing edges (or their costs) has changed
+	 */
+	void NotifyNodesChanged(TConstArrayView<LocationT> ChangedNodes)
+	{
+		for (const LocationT& Location : ChangedNodes) {
+			if (Location == Goal) {
+				continue;
+			}
+
+			// a node the search has never touched only needs tracking if it now leads into the searched region
+			const double NewRhs = GetBestSuccessorCost(Location);
+			if (!SlotLookup.Contains(Location) && !(NewRhs < Infinity)) {
+				continue;
+			}
+
+			const int32 Slot = FindOrAddSlot(Location);
+			States[Slot].Rhs = NewRhs;
+			UpdateState(Slot);
+		}
+	}
+
+	/**
+	 * @return The current shortest path from the start to the goal, or an empty array if there is none
+	 *
+	 * @note Only meaningful after Plan has brought the search up to date.
+	 */
+	TArray<LocationT> GetPath() const
+	{
+		TArray<LocationT> Result;
+		const int32* StartSlot = SlotLookup.Find(Start);
+		if (!StartSlot || !(States[*StartSlot].G < Infinity)) {
+			return Result;
+		}
+
+		// each step strictly lowers the remaining cost, so a path can never visit more nodes than the search knows
+		LocationT CurrLocation = Start;
+		Result.Push(CurrLocation);
+		while (CurrLocation != Goal && Result.Num() <= States.Num()) {
+			double BestCost = Infinity;
+			LocationT BestLocation = CurrLocation;
+			Map->ForEachReachableNeighbor(CurrLocation, [&](const LocationT& NextLocation, const double EdgeCost)
+			{
+				const double ViaNext = CostT::GetCost(CurrLocation, NextLocation, EdgeCost) + GetG(NextLocation);
+				if (ViaNext < BestCost) {
+					BestCost = ViaNext;
+					BestLocation = NextLocation;
+				}
+			});
+
+			if (!(BestCost < Infinity)) {
+				return {};
+			}
+			CurrLocation = BestLocation;
+			Result.Push(CurrLocation);
+		}
+
+		return CurrLocation == Goal ? Result : TArray<LocationT>();
+	}
+
+	FORCEINLINE const LocationT& GetStart() const { return Start; }
+	FORCEINLINE const LocationT& GetGoal() const { return Goal; }
+
+	// number of nodes processed by the most recent call to Plan
+	FORCEINLINE int32 GetNumExpansions() const { return NumExpansions; }
+
+	// number of nodes the search has stored state for
+	FORCEINLINE int32 GetNumStates() const { return States.Num(); }
+
+private:
+	static constexpr double Infinity = TNumericLimits<double>::Max();
+
+	struct FState
+	{
+		LocationT Location;
+
+		// cost to the goal as of the node's last expansion
+		double G;
+
+		// one-step lookahead cost to the goal, based on its successors' G values
+		double Rhs;
+	};
+
+	int32 FindOrAddSlot(const LocationT& Location)
+	{
+		if (const int32* ExistingSlot = SlotLookup.Find(Location)) {
+			return *ExistingSlot;
+		}
+		const int32 NewSlot = States.Add({ Location, Infinity, Infinity });
+		SlotLookup.Add(Location, NewSlot);
+		return NewSlot;
+	}
+
+	double GetG(const LocationT& Location) const
+	{
+		const int32* Slot = SlotLookup.Find(Location);
+		return Slot ? States[*Slot].G : Infinity;
+	}
+
+	double GetBestSuccessorCost(const LocationT& Location) const
+	{
+		double BestCost = Infinity;
+		Map->ForEachReachableNeighbor(Location, [&](const LocationT& NextLocation, const double EdgeCost)
+		{
+			const double NextG = GetG(NextLocation);
+			if (NextG < Infinity) {
+				BestCost = FMath::Min(BestCost, CostT::GetCost(Location, NextLocation, EdgeCost) + NextG);
+			}
+		});
+		return BestCost;
+	}
+
+	FDStarLiteKey CalculateKey(const int32 Slot) const
+	{
+		const FState& State = States[Slot];
+		const double MinCost = FMath::Min(State.G, State.Rhs);
+		if (!(MinCost < Infinity)) {
+			return { Infinity, Infinity };
+		}
+		return { MinCost + HeuristicT::Estimate(Start, State.Location) + KeyModifier, MinCost };
+	}
+
+	/**
+	 * @brief Whether a node with key StartKey is already settled given that the best queued key is TopKey.
+	 *
+	 * Keys along the same path are sums of different edges and heuristic terms, so nodes that should tie on the
+	 * primary key can differ by rounding error. Treating near-ties as ties only ever expands a few more nodes,
+	 * whereas stopping early on one would leave an inconsistent node on the start's shortest path.
+	 */
+	static bool IsSettledBefore(const FDStarLiteKey& StartKey, const FDStarLiteKey& TopKey)
+	{
+		if (StartKey.Primary < TopKey.Primary - UE_KINDA_SMALL_NUMBER) {
+			return true;
+		}
+		return StartKey.Primary <= TopKey.Primary + UE_KINDA_SMALL_NUMBER && StartKey.Secondary < TopKey.Secondary - UE_KINDA_SMALL_NUMBER;
+	}
+
+	void UpdateState(const int32 Slot)
+	{
+		const FState& State = States[Slot];
+		if (State.G != State.Rhs) {
+			OpenSet.Update(Slot, CalculateKey(Slot));
+		}
+		else {
+			OpenSet.Remove(Slot);
+		}
+	}
+
+	const MapT* Map;
+	ReverseMapT ReverseMap;
+
+	LocationT Start;
+	LocationT Goal;
+	double KeyModifier = 0.0;
+
+	TArray<FState> States;
+	TMap<LocationT, int32> SlotLookup;
+	TIndexedPriorityQueue<int32, 4, FDStarLiteKey> OpenSet;
+
+	int32 NumExpansions = 0;
+};
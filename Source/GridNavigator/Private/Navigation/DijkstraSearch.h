@@ -0,0 +1,99 @@
+#pragma once
+
+#include "AStarNavigator.h"
+
+/**
+ * @brief One-to-all shortest path search over any map that satisfies can_query_nodes, optionally bounded by cost.
+ *
+ * Results are left in the provided arena: every settled location has a record with its final cost from
+ * the start location (GCost), the slot of its predecessor (ParentSlot), and bClosed set.
+ *
+ * @tparam CostT Edge cost policy (see SearchPolicies.h)
+ * @tparam OpenSetT Priority queue used for the open set; see TAStarNavigator
+ */
+template <typename MapT, typename LocationT, typename CostT = GridNavigatorSearch::FStoredEdgeCost, typename OpenSetT = TIndexedPriorityQueue<int32>>
+requires can_query_nodes<MapT, LocationT> && is_edge_cost_policy<CostT, LocationT>
+class TDijkstraSearch
+{
+public:
+	typedef TAStarSearchArena<LocationT, OpenSetT> FSearchArena;
+
+	/**
+	 * @brief Settles every location reachable from StartLocation in Map.
+	 *
+	 * @param Map The map to search
+	 * @param StartLocation The location that all costs are measured from
+	 * @param Arena Receives the search results; reset at the start of the search
+	 * @param CostLimit Locations that cost more than this to reach are left unsettled and never expanded
+	 */
+	static void Run(const MapT& Map, const LocationT& StartLocation, FSearchArena& Arena, const double CostLimit = TNumericLimits<double>::Max())
+	{
+		RunUntil(Map, StartLocation, Arena, [](const LocationT&, double) { return false; }, CostLimit);
+	}
+
+	/**
+	 * @brief Settles locations in order of their cost from StartLocation until told to stop, eg. once every
+	 * location of interest has been reached.
+	 *
+	 * @param OnSettled Invoked as OnSettled(const LocationT& Location, double Cost) as each location is settled;
+	 * returning \c true ends the search, leaving the remaining locations unsettled
+	 *
+	 * @see Run for the other parameters
+	 */
+	template <typename CallableT>
+	static void RunUntil(const MapT& Map, const LocationT& StartLocation, FSearchArena& Arena, CallableT&& OnSettled, const double CostLimit = TNumericLimits<double>::Max())
+	{
+		Arena.Reset();
+		auto& OpenSet = Arena.OpenSet;
+
+		bool bWasAdded = false;
+		const int32 StartSlot = Arena.FindOrAdd(StartLocation, bWasAdded);
+		Arena[StartSlot].GCost = 0.0;
+		OpenSet.Push(StartSlot, 0.0);
+
+		while (!OpenSet.IsEmpty()) {
+			const int32 CurrSlot = OpenSet.Pop();
+			if (Arena[CurrSlot].bClosed) {
+				continue;
+			}
+			Arena[CurrSlot].bClosed = true;
+
+			const LocationT CurrLocation = Arena[CurrSlot].Location;
+			const double CurrCost = Arena[CurrSlot].GCost;
+
+			if (OnSettled(CurrLocation, CurrCost)) {
+				return;
+			}
+
+			if (!Map.HasNode(CurrLocation)) {
+				continue;
+			}
+
+			Map.ForEachReachableNeighbor(CurrLocation, [&](const LocationT& NeighborLocation, const double EdgeCost)
+			{
+				const double NeighborCost = CurrCost + CostT::GetCost(CurrLocation, NeighborLocation, EdgeCost);
+				if (NeighborCost > CostLimit) {
+					return;
+				}
+
+				const int32 NeighborSlot = Arena.FindOrAdd(NeighborLocation, bWasAdded);
+				auto& NeighborRecord = Arena[NeighborSlot];
+
+				if (NeighborCost < NeighborRecord.GCost) {
+					NeighborRecord.ParentSlot = CurrSlot;
+					NeighborRecord.GCost = NeighborCost;
+					OpenSet.Push(NeighborSlot, NeighborCost);
+				}
+			});
+		}
+	}
+
+	/**
+	 * @return The cost to reach Location in a completed search, or a negative value if it was not reached
+	 */
+	static double GetCost(const FSearchArena& Arena, const LocationT& Location)
+	{
+		const int32 Slot = Arena.Find(Location);
+		return Slot != INDEX_NONE && Arena[Slot].bClosed ? Arena[Slot].GCost : -1.0;
+	}
+};
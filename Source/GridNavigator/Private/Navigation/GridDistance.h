@@ -0,0 +1,18 @@
+#pragma once
+
+namespace UE::Math
+{
+	/**
+	 * @brief Euclidean distance between two grid indices, measured in grid cells.
+	 *
+	 * @note Lives in UE::Math so that the search templates find it through argument-dependent lookup.
+	 */
+	inline double Distance(const FInt64Vector3& Lhs, const FInt64Vector3& Rhs)
+	{
+		const FInt64Vector3 Diff = Rhs - Lhs;
+		const double XSquared = static_cast<double>(Diff.X) * static_cast<double>(Diff.X);
+		const double YSquared = static_cast<double>(Diff.Y) * static_cast<double>(Diff.Y);
+		const double ZSquared = static_cast<double>(Diff.Z) * static_cast<double>(Diff.Z);
+		return FMath::Sqrt(XSquared + YSquared + ZSquared);
+	}
+}
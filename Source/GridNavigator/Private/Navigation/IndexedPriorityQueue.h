@@ -0,0 +1,219 @@
+#pragma once
+
+#include <type_traits>
+
+/**
+ * @brief A d-ary min-heap over small, dense integer elements that supports in-place decrease-key.
+ *
+ * Each element's position in the heap is tracked in a handle array indexed by the element itself, so
+ * elements are expected to be dense slot indices (eg. slots in a TAStarSearchArena). An element is in the
+ * queue at most once; pushing an element that is already queued lowers its priority instead of adding
+ * a duplicate entry.
+ *
+ * @tparam ElementT Integral element type, used directly as an index into the handle array
+ * @tparam Arity Number of children per heap node; 4 keeps sift-downs shallow while staying cache-friendly
+ * @tparam PriorityT Priority type; only needs operator<, so compound (eg. lexicographic) keys can be used
+ */
+template <typename ElementT, int32 Arity = 4, typename PriorityT = double>
+class TIndexedPriorityQueue
+{
+	static_assert(std::is_integral_v<ElementT>, "TIndexedPriorityQueue elements must be dense integer indices");
+	static_assert(Arity >= 2, "TIndexedPriorityQueue requires an arity of at least 2");
+
+	struct FHeapEntry
+	{
+		ElementT Element;
+		PriorityT Priority;
+	};
+
+public:
+	/**
+	 * @brief Removes and returns the element with the lowest priority.
+	 *
+	 * @pre The queue must not be empty.
+	 */
+	ElementT Pop()
+	{
+		check(!Heap.IsEmpty());
+
+		const ElementT Top = Heap[0].Element;
+		Handles[Top] = INDEX_NONE;
+
+		const FHeapEntry LastEntry = Heap.Pop(false);
+		if (!Heap.IsEmpty()) {
+			Heap[0] = LastEntry;
+			SiftDown(0);
+		}
+
+		return Top;
+	}
+
+	/**
+	 * @brief Adds an element to the queue, or lowers its priority if it is already queued.
+	 *
+	 * @param Element The element to add or update
+	 * @param Priority The element's new priority; ignored if the element is queued with a lower priority
+	 */
+	void Push(const ElementT Element, const PriorityT& Priority)
+	{
+		while (Handles.Num() <= static_cast<int32>(Element)) {
+			Handles.Add(INDEX_NONE);
+		}
+
+		const int32 HeapIndex = Handles[Element];
+		if (HeapIndex == INDEX_NONE) {
+			const int32 NewIndex = Heap.Add({ Element, Priority });
+			SiftUp(NewIndex);
+		}
+		else if (Priority < Heap[HeapIndex].Priority) {
+			Heap[HeapIndex].Priority = Priority;
+			SiftUp(HeapIndex);
+		}
+	}
+
+	/**
+	 * @brief Adds an element to the queue, or changes its priority (up or down) if it is already queued.
+	 */
+	void Update(const ElementT Element, const PriorityT& Priority)
+	{
+		if (!Contains(Element)) {
+			Push(Element, Priority);
+			return;
+		}
+
+		const int32 HeapIndex = Handles[Element];
+		const bool bIsDecrease = Priority < Heap[HeapIndex].Priority;
+		Heap[HeapIndex].Priority = Priority;
+		if (bIsDecrease) {
+			SiftUp(HeapIndex);
+		}
+		else {
+			SiftDown(HeapIndex);
+		}
+	}
+
+	/**
+	 * @brief Removes an element from the queue; does nothing if it is not queued.
+	 */
+	void Remove(const ElementT Element)
+	{
+		if (!Contains(Element)) {
+			return;
+		}
+
+		const int32 HeapIndex = Handles[Element];
+		Handles[Element] = INDEX_NONE;
+
+		const FHeapEntry LastEntry = Heap.Pop(false);
+		if (HeapIndex < Heap.Num()) {
+			const bool bIsDecrease = LastEntry.Priority < Heap[HeapIndex].Priority;
+			Heap[HeapIndex] = LastEntry;
+			if (bIsDecrease) {
+				SiftUp(HeapIndex);
+			}
+			else {
+				SiftDown(HeapIndex);
+			}
+		}
+	}
+
+	/**
+	 * @return The element that would be popped next
+	 * @pre The queue must not be empty.
+	 */
+	ElementT Top() const
+	{
+		check(!Heap.IsEmpty());
+		return Heap[0].Element;
+	}
+
+	bool Contains(const ElementT Element) const
+	{
+		return Handles.IsValidIndex(Element) && Handles[Element] != INDEX_NONE;
+	}
+
+	bool IsEmpty() const
+	{
+		return Heap.IsEmpty();
+	}
+
+	int32 Num() const
+	{
+		return Heap.Num();
+	}
+
+	/**
+	 * @return The priority of the element that would be popped next
+	 * @pre The queue must not be empty.
+	 */
+	const PriorityT& GetMinPriority() const
+	{
+		check(!Heap.IsEmpty());
+		return Heap[0].Priority;
+	}
+
+	/**
+	 * @brief Removes all queued elements without releasing the queue's allocations.
+	 */
+	void Reset()
+	{
+		Heap.Reset();
+		Handles.Reset();
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Heap.GetAllocatedSize() + Handles.GetAllocatedSize();
+	}
+
+private:
+	void SiftUp(int32 Index)
+	{
+		const FHeapEntry Entry = Heap[Index];
+		while (Index > 0) {
+			const int32 ParentIndex = (Index - 1) / Arity;
+			if (!(Entry.Priority < Heap[ParentIndex].Priority)) {
+				break;
+			}
+			Heap[Index] = Heap[ParentIndex];
+			Handles[Heap[Index].Element] = Index;
+			Index = ParentIndex;
+		}
+		Heap[Index] = Entry;
+		Handles[Entry.Element] = Index;
+	}
+
+	void SiftDown(int32 Index)
+	{
+		const FHeapEntry Entry = Heap[Index];
+		const int32 NumEntries = Heap.Num();
+		while (true) {
+			const int32 FirstChild = Index * Arity + 1;
+			if (FirstChild >= NumEntries) {
+				break;
+			}
+
+			int32 BestChild = FirstChild;
+			const int32 EndChild = FMath::Min(FirstChild + Arity, NumEntries);
+			for (int32 Child = FirstChild + 1; Child < EndChild; ++Child) {
+				if (Heap[Child].Priority < Heap[BestChild].Priority) {
+					BestChild = Child;
+				}
+			}
+
+			if (!(Heap[BestChild].Priority < Entry.Priority)) {
+				break;
+			}
+			Heap[Index] = Heap[BestChild];
+			Handles[Heap[Index].Element] = Index;
+			Index = BestChild;
+		}
+		Heap[Index] = Entry;
+		Handles[Entry.Element] = Index;
+	}
+
+	TArray<FHeapEntry> Heap;
+
+	// position of each element within Heap, or INDEX_NONE if the element is not queued
+	TArray<int32> Handles;
+};
@@ -0,0 +1,373 @@
+#pragma once
+
+#include "Containers/StaticArray.h"
+#include "AStarNavigator.h"
+
+template <typename MapT, typename LocationT>
+concept can_query_direct_edges = requires(MapT Map, LocationT Index, uint8& Mask, bool& bHasNonDirectEdges) {
+	{ Map.GetDirectEdgeMask(Index, Mask, bHasNonDirectEdges) } -> std::convertible_to<bool>;
+};
+
+/**
+ * @brief Jump point search over the eight-connected, same-height Direct edges of a map.
+ *
+ * Flat regions are crossed by jumping in straight lines instead of expanding every node, which removes the
+ * symmetric expansion plain A* performs on open ground. Because map edges can be missing independently of
+ * nodes (eg. walls between two valid cells), a neighbor is only pruned when an equally short canonical route
+ * to it exists through edges that are actually present; any other neighbor is treated as forced. Nodes that
+ * have slope or height-change edges are always jump points and are expanded like plain A* nodes.
+ *
+ * @tparam HeuristicT Heuristic policy (see SearchPolicies.h); see TAStarNavigator
+ * @tparam CostT Edge cost policy (see SearchPolicies.h); a straight flat jump is costed as a single edge
+ * @tparam OpenSetT Priority queue used for the open set; see TAStarNavigator
+ */
+template <
+	typename MapT,
+	typename LocationT,
+	typename HeuristicT = GridNavigatorSearch::FOctileHeuristic2D,
+	typename CostT = GridNavigatorSearch::FStoredEdgeCost,
+	typename OpenSetT = TIndexedPriorityQueue<int32>>
+requires can_query_nodes<MapT, LocationT> && can_query_direct_edges<MapT, LocationT>
+	&& is_heuristic_policy<HeuristicT, LocationT> && is_edge_cost_policy<CostT, LocationT>
+class TJumpPointNavigator
+{
+public:
+	typedef TAStarSearchArena<LocationT, OpenSetT> FSearchArena;
+
+	// number of nodes expanded by the most recent search; jumped-over nodes are not counted
+	int32 NumExpansions = 0;
+
+	// jump points whose f-cost is above this are never opened, so paths that cost more are not found
+	double CostLimit = TNumericLimits<double>::Max();
+
+	/**
+	 * @brief Performs jump point search between two points on a provided map.
+	 *
+	 * @param Map The map on which navigation is performed
+	 * @param StartLocation The starting location for pathfinding
+	 * @param FinalLocation The target location for pathfinding
+	 *
+	 * @return Every node along the path from StartLocation to FinalLocation, including the nodes that were
+	 * jumped over, or an empty array if no path exists.
+	 */
+	TArray<LocationT> Navigate(const MapT& Map, const LocationT& StartLocation, const LocationT& FinalLocation)
+	{
+		return Navigate(Map, StartLocation, FinalLocation, FSearchArena::Get());
+	}
+
+	/**
+	 * @see Navigate(const MapT&, const LocationT&, const LocationT&)
+	 */
+	TArray<LocationT> Navigate(const MapT& Map, const LocationT& StartLocation, const LocationT& FinalLocation, FSearchArena& Arena)
+	{
+		Arena.Reset();
+		NumExpansions = 0;
+		auto& OpenSet = Arena.OpenSet;
+
+		bool bWasAdded = false;
+		const int32 StartSlot = Arena.FindOrAdd(StartLocation, bWasAdded);
+		Arena[StartSlot].GCost = 0.0;
+		OpenSet.Push(StartSlot, 0);
+
+		int32 CurrSlot = INDEX_NONE;
+		bool IsNavigationSuccessful = false;
+		while (!OpenSet.IsEmpty()) {
+			CurrSlot = OpenSet.Pop();
+			check(CurrSlot != INDEX_NONE);
+
+			if (Arena[CurrSlot].bClosed) {
+				continue;
+			}
+			Arena[CurrSlot].bClosed = true;
+			++NumExpansions;
+
+			const LocationT CurrLocation = Arena[CurrSlot].Location;
+			const double CurrCost = Arena[CurrSlot].GCost;
+			const int32 ParentSlot = Arena[CurrSlot].ParentSlot;
+
+			if (CurrLocation == FinalLocation) {
+				IsNavigationSuccessful = true;
+				break;
+			}
+
+			uint8 CurrMask = 0;
+			bool bCurrHasNonDirectEdges = false;
+			if (!Map.GetDirectEdgeMask(CurrLocation, CurrMask, bCurrHasNonDirectEdges)) {
+				continue;
+			}
+
+			const auto Relax = [&](const LocationT& Successor, const double StepCost)
+			{
+				const double SuccessorCost = CurrCost + StepCost;
+				const double Priority = SuccessorCost + HeuristicT::Estimate(Successor, FinalLocation);
+				if (Priority > CostLimit) {
+					return;
+				}
+
+				const int32 SuccessorSlot = Arena.FindOrAdd(Successor, bWasAdded);
+				auto& SuccessorRecord = Arena[SuccessorSlot];
+
+				if (SuccessorCost < SuccessorRecord.GCost) {
+					SuccessorRecord.ParentSlot = CurrSlot;
+					SuccessorRecord.GCost = SuccessorCost;
+					SuccessorRecord.bClosed = false;
+					OpenSet.Push(SuccessorSlot, Priority);
+				}
+			};
+
+			// pruning is only valid for nodes entered by a flat jump; anything else gets a full expansion
+			const int32 IncomingDirection = (ParentSlot != INDEX_NONE && !bCurrHasNonDirectEdges)
+				? GetJumpDirection(Arena[ParentSlot].Location, CurrLocation)
+				: INDEX_NONE;
+
+			if (IncomingDirection == INDEX_NONE) {
+				for (int32 Direction = 0; Direction < NavGrid::NumDirections; ++Direction) {
+					LocationT JumpPoint;
+					if ((CurrMask & (1 << Direction)) && Jump(Map, CurrLocation, CurrMask, Direction, FinalLocation, JumpPoint)) {
+						Relax(JumpPoint, CostT::GetCost(CurrLocation, JumpPoint, Distance(CurrLocation, JumpPoint)));
+					}
+				}
+
+				if (bCurrHasNonDirectEdges) {
+					Map.ForEachReachableNeighbor(CurrLocation, [&](const LocationT& NeighborLocation, const double EdgeCost)
+					{
+						if (!IsDirectStep(CurrLocation, CurrMask, NeighborLocation)) {
+							Relax(NeighborLocation, CostT::GetCost(CurrLocation, NeighborLocation, EdgeCost));
+						}
+					});
+				}
+				continue;
+			}
+
+			const LocationT PrevLocation = Step(CurrLocation, Opposite(IncomingDirection));
+			uint8 PrevMask = 0;
+			bool bPrevHasNonDirectEdges = false;
+			Map.GetDirectEdgeMask(PrevLocation, PrevMask, bPrevHasNonDirectEdges);
+
+			for (int32 Direction = 0; Direction < NavGrid::NumDirections; ++Direction) {
+				if (!(CurrMask & (1 << Direction)) || IsPruned(Map, PrevLocation, PrevMask, IncomingDirection, Direction)) {
+					continue;
+				}
+				LocationT JumpPoint;
+				if (Jump(Map, CurrLocation, CurrMask, Direction, FinalLocation, JumpPoint)) {
+					Relax(JumpPoint, CostT::GetCost(CurrLocation, JumpPoint, Distance(CurrLocation, JumpPoint)));
+				}
+			}
+		}
+
+		INC_DWORD_STAT_BY(STAT_GridNavigator_NodesExpanded, NumExpansions);
+
+		TArray<LocationT> Result;
+		if (IsNavigationSuccessful) {
+			while (CurrSlot != INDEX_NONE) {
+				const auto& CurrRecord = Arena[CurrSlot];
+				Result.Push(CurrRecord.Location);
+
+				// fill in the nodes that were jumped over between this jump point and its parent
+				if (CurrRecord.ParentSlot != INDEX_NONE) {
+					const LocationT& ParentLocation = Arena[CurrRecord.ParentSlot].Location;
+					const int32 Direction = GetJumpDirection(ParentLocation, CurrRecord.Location);
+					if (Direction != INDEX_NONE) {
+						const int32 BackDirection = Opposite(Direction);
+						for (LocationT Between = Step(CurrRecord.Location, BackDirection); Between != ParentLocation; Between = Step(Between, BackDirection)) {
+							Result.Push(Between);
+						}
+					}
+				}
+
+				CurrSlot = CurrRecord.ParentSlot;
+			}
+			Algo::Reverse(Result);
+		}
+
+		return Result;
+	}
+
+private:
+	static FORCEINLINE LocationT Step(const LocationT& Location, const int32 Direction)
+	{
+		return LocationT(Location.X + NavGrid::DirectionOffsetX[Direction], Location.Y + NavGrid::DirectionOffsetY[Direction], Location.Z);
+	}
+
+	static FORCEINLINE int32 Opposite(const int32 Direction)
+	{
+		return (Direction + NavGrid::NumDirections / 2) % NavGrid::NumDirections;
+	}
+
+	static FORCEINLINE double StepCost(const int32 Direction)
+	{
+		return NavGrid::IsDiagonalDirection(Direction) ? UE_DOUBLE_SQRT_2 : 1.0;
+	}
+
+	/**
+	 * @return The direction of a straight or diagonal same-height run from From to To, or INDEX_NONE if the two
+	 * locations are not connected by such a run.
+	 */
+	static int32 GetJumpDirection(const LocationT& From, const LocationT& To)
+	{
+		const auto DX = To.X - From.X;
+		const auto DY = To.Y - From.Y;
+		if (To.Z != From.Z || (DX == 0 && DY == 0) || (DX != 0 && DY != 0 && FMath::Abs(DX) != FMath::Abs(DY))) {
+			return INDEX_NONE;
+		}
+		return NavGrid::GetDirectionIndex(FMath::Sign(DX), FMath::Sign(DY));
+	}
+
+	static bool IsDirectStep(const LocationT& From, const uint8 FromMask, const LocationT& To)
+	{
+		if (To.Z != From.Z) {
+			return false;
+		}
+		const int32 Direction = NavGrid::GetDirectionIndex(To.X - From.X, To.Y - From.Y);
+		return Direction != INDEX_NONE && (FromMask & (1 << Direction));
+	}
+
+	/**
+	 * @brief Checks whether the neighbor of a node can be reached from the node's predecessor without passing
+	 * through the node, at a cost no greater than going through it (ties go to routes that move diagonally
+	 * first, which is the canonical ordering jump point search relies on).
+	 *
+	 * @param Map Map to query edges from; if null, every edge is assumed to exist
+	 * @param PrevLocation The predecessor, one step behind the node along IncomingDirection
+	 * @param PrevMask Direct edge mask of the predecessor
+	 * @param IncomingDirection Direction of travel from the predecessor into the node
+	 * @param Direction Direction from the node to the neighbor being tested
+	 */
+	static bool IsPruned(const MapT* Map, const LocationT& PrevLocation, const uint8 PrevMask, const int32 IncomingDirection, const int32 Direction)
+	{
+		const int32 TargetX = NavGrid::DirectionOffsetX[IncomingDirection] + NavGrid::DirectionOffsetX[Direction];
+		const int32 TargetY = NavGrid::DirectionOffsetY[IncomingDirection] + NavGrid::DirectionOffsetY[Direction];
+
+		// stepping back to the predecessor is never useful
+		if (TargetX == 0 && TargetY == 0) {
+			return true;
+		}
+
+		const double CostThroughNode = StepCost(IncomingDirection) + StepCost(Direction);
+
+		// neighbor is adjacent to the predecessor, so a single (cheaper) edge replaces the two through the node
+		const int32 DirectDirection = NavGrid::GetDirectionIndex(TargetX, TargetY);
+		if (DirectDirection != INDEX_NONE) {
+			return !Map || (PrevMask & (1 << DirectDirection));
+		}
+
+		for (int32 FirstDirection = 0; FirstDirection < NavGrid::NumDirections; ++FirstDirection) {
+			if (FirstDirection == IncomingDirection) {
+				continue;
+			}
+
+			const int32 SecondDirection = NavGrid::GetDirectionIndex(TargetX - NavGrid::DirectionOffsetX[FirstDirection], TargetY - NavGrid::DirectionOffsetY[FirstDirection]);
+			if (SecondDirection == INDEX_NONE) {
+				continue;
+			}
+
+			const double AlternativeCost = StepCost(FirstDirection) + StepCost(SecondDirection);
+			const bool bIsCheaper = AlternativeCost < CostThroughNode - UE_KINDA_SMALL_NUMBER;
+			const bool bIsCanonicalTie = FMath::Abs(AlternativeCost - CostThroughNode) <= UE_KINDA_SMALL_NUMBER
+				&& NavGrid::IsDiagonalDirection(FirstDirection) && !NavGrid::IsDiagonalDirection(IncomingDirection);
+			if (!bIsCheaper && !bIsCanonicalTie) {
+				continue;
+			}
+
+			if (!Map) {
+				return true;
+			}
+			if (!(PrevMask & (1 << FirstDirection))) {
+				continue;
+			}
+
+			uint8 MiddleMask = 0;
+			bool bMiddleHasNonDirectEdges = false;
+			if (Map->GetDirectEdgeMask(Step(PrevLocation, FirstDirection), MiddleMask, bMiddleHasNonDirectEdges) && (MiddleMask & (1 << SecondDirection))) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	static FORCEINLINE bool IsPruned(const MapT& Map, const LocationT& PrevLocation, const uint8 PrevMask, const int32 IncomingDirection, const int32 Direction)
+	{
+		return IsPruned(&Map, PrevLocation, PrevMask, IncomingDirection, Direction);
+	}
+
+	static bool IsPrunedOnOpenGround(const int32 IncomingDirection, const int32 Direction)
+	{
+		static const auto PrunedOnOpenGround = []
+		{
+			TStaticArray<TStaticArray<bool, NavGrid::NumDirections>, NavGrid::NumDirections> Table;
+			for (int32 Incoming = 0; Incoming < NavGrid::NumDirections; ++Incoming) {
+				for (int32 Outgoing = 0; Outgoing < NavGrid::NumDirections; ++Outgoing) {
+					Table[Incoming][Outgoing] = IsPruned(nullptr, LocationT(), 0, Incoming, Outgoing);
+				}
+			}
+			return Table;
+		}();
+		return PrunedOnOpenGround[IncomingDirection][Direction];
+	}
+
+	/**
+	 * @return \c true if the node has a neighbor that would be pruned on open ground, but that cannot be reached
+	 * canonically from its predecessor with the edges that actually exist
+	 */
+	static bool HasForcedNeighbor(const MapT& Map, const uint8 Mask, const LocationT& PrevLocation, const uint8 PrevMask, const int32 IncomingDirection)
+	{
+		for (int32 Direction = 0; Direction < NavGrid::NumDirections; ++Direction) {
+			if ((Mask & (1 << Direction)) && IsPrunedOnOpenGround(IncomingDirection, Direction) && !IsPruned(Map, PrevLocation, PrevMask, IncomingDirection, Direction)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Scans from a node in one direction until a jump point is found.
+	 *
+	 * @param FromMask Direct edge mask of From; must include Direction
+	 * @param OutJumpPoint Receives the jump point, if one was found
+	 * @return \c true if a jump point was found; \c false if the scan ran into a dead end
+	 */
+	static bool Jump(const MapT& Map, const LocationT& From, const uint8 FromMask, const int32 Direction, const LocationT& FinalLocation, LocationT& OutJumpPoint)
+	{
+		LocationT PrevLocation = From;
+		uint8 PrevMask = FromMask;
+
+		while (true) {
+			const LocationT CurrLocation = Step(PrevLocation, Direction);
+			if (CurrLocation == FinalLocation) {
+				OutJumpPoint = CurrLocation;
+				return true;
+			}
+
+			uint8 CurrMask = 0;
+			bool bCurrHasNonDirectEdges = false;
+			if (!Map.GetDirectEdgeMask(CurrLocation, CurrMask, bCurrHasNonDirectEdges)) {
+				return false;
+			}
+
+			if (bCurrHasNonDirectEdges || HasForcedNeighbor(Map, CurrMask, PrevLocation, PrevMask, Direction)) {
+				OutJumpPoint = CurrLocation;
+				return true;
+			}
+
+			// diagonal moves stop wherever one of their straight components would find a jump point
+			if (NavGrid::IsDiagonalDirection(Direction)) {
+				const int32 StraightDirections[2] = { (Direction + 7) % NavGrid::NumDirections, (Direction + 1) % NavGrid::NumDirections };
+				for (const int32 StraightDirection : StraightDirections) {
+					LocationT StraightJumpPoint;
+					if ((CurrMask & (1 << StraightDirection)) && Jump(Map, CurrLocation, CurrMask, StraightDirection, FinalLocation, StraightJumpPoint)) {
+						OutJumpPoint = CurrLocation;
+						return true;
+					}
+				}
+			}
+
+			if (!(CurrMask & (1 << Direction))) {
+				return false;
+			}
+
+			PrevLocation = CurrLocation;
+			PrevMask = CurrMask;
+		}
+	}
+};
@@ -0,0 +1,117 @@
+#include "NavGridAsyncQueryQueue.h"
+
+#include "Async/ParallelFor.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogNavGridAsyncQueryQueue, Log, All)
+
+FNavGridQueryBatchTask::FNavGridQueryBatchTask(TArray<FNavGridAsyncPathRequest>&& NewRequests) : Requests(MoveTemp(NewRequests)) {}
+
+TStatId FNavGridQueryBatchTask::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(GNPathQueryBatchTask, STATGROUP_ThreadPoolAsyncTasks);
+}
+
+void FNavGridQueryBatchTask::DoWork()
+{
+	// FindPath only reads the pinned snapshot and locks the path cache, so queries of a batch can run side by side
+	ParallelFor(Requests.Num(), [this](const int32 RequestIndex)
+	{
+		FNavGridAsyncPathRequest& Request = Requests[RequestIndex];
+		const ANavigationData* NavData = Request.Query.NavData.Get();
+		if (NavData == nullptr) {
+			Request.Result = FPathFindingResult(ENavigationQueryResult::Error);
+			return;
+		}
+		Request.Result = NavData->FindPath(Request.AgentProperties, Request.Query);
+	});
+}
+
+FNavGridAsyncQueryQueue::FNavGridAsyncQueryQueue()
+{
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FNavGridAsyncQueryQueue::Tick));
+}
+
+FNavGridAsyncQueryQueue::~FNavGridAsyncQueryQueue()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	for (const TUniquePtr<FAsyncBatchTask>& Batch : BatchesInFlight) {
+		Batch->EnsureCompletion();
+	}
+	BatchesInFlight.Empty();
+}
+
+uint32 FNavGridAsyncQueryQueue::Enqueue(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query, const FNavPathQueryDelegate& ResultDelegate)
+{
+	FNavGridAsyncPathRequest Request;
+	Request.QueryID = NextQueryID.fetch_add(1, std::memory_order_relaxed);
+	Request.AgentProperties = AgentProperties;
+	Request.Query = Query;
+	Request.OnDone = ResultDelegate;
+
+	const uint32 QueryID = Request.QueryID;
+	PendingRequests.Enqueue(MoveTemp(Request));
+	return QueryID;
+}
+
+void FNavGridAsyncQueryQueue::Flush()
+{
+	check(IsInGameThread());
+
+	DispatchCompletedBatches(true);
+}
+
+void FNavGridAsyncQueryQueue::CancelPending()
+{
+	check(IsInGameThread());
+
+	FNavGridAsyncPathRequest Request;
+	int32 NumCancelled = 0;
+	while (PendingRequests.Dequeue(Request)) {
+		Request.OnDone.ExecuteIfBound(Request.QueryID, ENavigationQueryResult::Error, FNavPathSharedPtr());
+		++NumCancelled;
+	}
+
+	if (NumCancelled > 0) {
+		UE_LOG(LogNavGridAsyncQueryQueue, Verbose, TEXT("Cancelled %d async path queries that had not started"), NumCancelled);
+	}
+}
+
+bool FNavGridAsyncQueryQueue::Tick(float DeltaTime)
+{
+	DispatchCompletedBatches(false);
+
+	TArray<FNavGridAsyncPathRequest> Batch;
+	FNavGridAsyncPathRequest Request;
+	while (PendingRequests.Dequeue(Request)) {
+		Batch.Add(MoveTemp(Request));
+	}
+
+	if (!Batch.IsEmpty()) {
+		UE_LOG(LogNavGridAsyncQueryQueue, Verbose, TEXT("Starting batch of %d async path queries"), Batch.Num());
+		FAsyncBatchTask& NewBatch = *BatchesInFlight.Add_GetRef(MakeUnique<FAsyncBatchTask>(MoveTemp(Batch)));
+		NewBatch.StartBackgroundTask();
+	}
+
+	return true;
+}
+
+void FNavGridAsyncQueryQueue::DispatchCompletedBatches(const bool bWaitForCompletion)
+{
+	// a batch that finished early waits for the ones started before it, so results keep their order
+	while (!BatchesInFlight.IsEmpty()) {
+		if (bWaitForCompletion) {
+			BatchesInFlight[0]->EnsureCompletion();
+		}
+		else if (!BatchesInFlight[0]->IsDone()) {
+			return;
+		}
+
+		// take ownership first, since result delegates are free to queue more queries
+		const TUniquePtr<FAsyncBatchTask> CompletedBatch = MoveTemp(BatchesInFlight[0]);
+		BatchesInFlight.RemoveAt(0);
+		for (auto& Request : CompletedBatch->GetTask().Requests) {
+			Request.OnDone.ExecuteIfBound(Request.QueryID, Request.Result.Result, Request.Result.Path);
+		}
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+
+#include "Async/AsyncWork.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "NavigationData.h"
+
+/**
+ * @brief A pathfinding query waiting to be run, or one that has been run and is waiting to report its result.
+ */
+struct FNavGridAsyncPathRequest
+{
+	uint32 QueryID = 0;
+	FNavAgentProperties AgentProperties;
+	FPathFindingQuery Query;
+	FNavPathQueryDelegate OnDone;
+	FPathFindingResult Result;
+};
+
+/**
+ * @brief Runs a batch of pathfinding queries on a worker thread, spreading the queries over the task graph's
+ * workers with ParallelFor.
+ */
+class FNavGridQueryBatchTask : public FNonAbandonableTask
+{
+public:
+	explicit FNavGridQueryBatchTask(TArray<FNavGridAsyncPathRequest>&& NewRequests);
+
+	TStatId GetStatId() const;
+
+	void DoWork();
+
+	TArray<FNavGridAsyncPathRequest> Requests;
+};
+
+/**
+ * @class FNavGridAsyncQueryQueue
+ * @brief Collects pathfinding queries from any thread and runs them off the game thread in per-frame batches.
+ *
+ * Requests are pushed onto a lock-free queue. Once per frame, the game thread drains everything that has been
+ * queued into a single batch and hands it to a worker task, which runs the batch's queries in parallel, so the
+ * cost of scheduling work and reporting results is paid per frame rather than per query. A new batch starts
+ * every frame that has queries queued, even while earlier batches are still running. Results are delivered
+ * through each query's FNavPathQueryDelegate on the game thread, batch by batch in the order the batches were
+ * started, with the same arguments UNavigationSystemV1::FindPathAsync uses.
+ */
+class FNavGridAsyncQueryQueue
+{
+public:
+	FNavGridAsyncQueryQueue();
+	~FNavGridAsyncQueryQueue();
+
+	/**
+	 * @brief Queues a query to run with the next batch. Safe to call from any thread.
+	 *
+	 * @param AgentProperties Properties of the agent the path is for
+	 * @param Query The query to run; its NavData must outlive the queue or be flushed before destruction
+	 * @param ResultDelegate Called on the game thread once the query has finished
+	 * @return ID of the query, which is also passed to ResultDelegate
+	 */
+	uint32 Enqueue(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query, const FNavPathQueryDelegate& ResultDelegate);
+
+	/**
+	 * @brief Blocks until every batch in flight has finished, and reports their results.
+	 *
+	 * @note Must be called on the game thread. Queries that have not been picked up by a batch stay queued.
+	 */
+	void Flush();
+
+	/**
+	 * @brief Drops every query that has not been picked up by a batch yet, reporting ENavigationQueryResult::Error
+	 * through its delegate, including queries those delegates queue in turn.
+	 *
+	 * @note Must be called on the game thread. Batches in flight are not affected; see Flush.
+	 */
+	void CancelPending();
+
+private:
+	bool Tick(float DeltaTime);
+	void DispatchCompletedBatches(bool bWaitForCompletion);
+
+	typedef FAsyncTask<FNavGridQueryBatchTask> FAsyncBatchTask;
+
+	TQueue<FNavGridAsyncPathRequest, EQueueMode::Mpsc> PendingRequests;
+	// oldest first, so that results are reported in the order the batches were started
+	TArray<TUniquePtr<FAsyncBatchTask>> BatchesInFlight;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	static inline std::atomic<uint32> NextQueryID = 1;
+};
@@ -0,0 +1,47 @@
+#include "NavGridChangeJournal.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogNavGridChangeJournal, Log, All)
+
+FNavGridChangeJournal::FNavGridChangeJournal(const int32 NewMaxEntries) : MaxEntries(FMath::Max(NewMaxEntries, 1)) {}
+
+void FNavGridChangeJournal::Record(const uint32 GraphVersion, TArray<FInt64Vector3>&& ChangedNodes)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	UE_LOG(LogNavGridChangeJournal, Verbose, TEXT("Graph version %u changed %d nodes"), GraphVersion, ChangedNodes.Num());
+
+	if (Entries.Num() >= MaxEntries) {
+		Entries.RemoveAt(0);
+	}
+	Entries.Add({ GraphVersion, MoveTemp(ChangedNodes) });
+}
+
+bool FNavGridChangeJournal::GetChangedNodesSince(const uint32 SinceVersion, const uint32 UpToVersion, TArray<FInt64Vector3>& OutChangedNodes) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	OutChangedNodes.Reset();
+
+	uint32 ExpectedVersion = SinceVersion + 1;
+	for (const auto& [GraphVersion, ChangedNodes] : Entries) {
+		if (GraphVersion < ExpectedVersion) {
+			continue;
+		}
+		if (GraphVersion > UpToVersion) {
+			break;
+		}
+		if (GraphVersion != ExpectedVersion) {
+			return false;
+		}
+		OutChangedNodes.Append(ChangedNodes);
+		++ExpectedVersion;
+	}
+
+	return ExpectedVersion == UpToVersion + 1;
+}
+
+void FNavGridChangeJournal::Clear()
+{
+	FScopeLock ScopeLock(&Lock);
+	Entries.Empty();
+}
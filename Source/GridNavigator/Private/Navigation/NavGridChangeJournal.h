@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @class FNavGridChangeJournal
+ * @brief A short, thread-safe history of which graph nodes changed with each graph version.
+ *
+ * Lets incremental searches catch up with a rebuilt graph by repairing only the nodes that changed since the
+ * version they were last synchronized with. Only the most recent versions are kept; searches that fall further
+ * behind (or that span a version with no recorded changes, such as a reload) have to start over.
+ */
+class FNavGridChangeJournal
+{
+public:
+	explicit FNavGridChangeJournal(int32 NewMaxEntries = 16);
+
+	/**
+	 * @brief Records the nodes that changed to produce a graph version.
+	 *
+	 * @param GraphVersion The version the changes produced (see ANavigationGridData::GetGraphVersion)
+	 * @param ChangedNodes Nodes whose traversable outgoing edges differ from the previous version
+	 */
+	void Record(uint32 GraphVersion, TArray<FInt64Vector3>&& ChangedNodes);
+
+	/**
+	 * @brief Collects every node that changed after one graph version, up to and including another.
+	 *
+	 * @param SinceVersion The version the caller is synchronized with
+	 * @param UpToVersion The version the caller wants to catch up to
+	 * @param OutChangedNodes Receives the changed nodes; may contain duplicates
+	 * @return \c true if every version in between was recorded; \c false if the caller has to start over
+	 */
+	bool GetChangedNodesSince(uint32 SinceVersion, uint32 UpToVersion, TArray<FInt64Vector3>& OutChangedNodes) const;
+
+	void Clear();
+
+private:
+	struct FEntry
+	{
+		uint32 GraphVersion;
+		TArray<FInt64Vector3> ChangedNodes;
+	};
+
+	mutable FCriticalSection Lock;
+
+	// oldest entry first
+	TArray<FEntry> Entries;
+	int32 MaxEntries;
+};
@@ -0,0 +1,107 @@
+#include "NavGridCostMatrix.h"
+
+#include "DijkstraSearch.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogNavGridCostMatrix, Log, All)
+
+namespace
+{
+	/**
+	 * @brief Runs one search from each origin over SearchMap, stopping each as soon as every destination in the
+	 * graph has been settled, and writes the costs it finds into the matrix.
+	 *
+	 * @param bOriginsAreSources \c true if the origins index the matrix's rows; \c false if they index its columns
+	 * (ie. SearchMap is the reversed graph and the searches run from the targets back to the sources)
+	 */
+	template <typename MapT>
+	void SearchFromEachOrigin(
+		const MapT& SearchMap,
+		const TConstArrayView<uint32> Origins,
+		const TConstArrayView<uint32> Destinations,
+		const bool bOriginsAreSources,
+		const int32 NumTargets,
+		const double CostLimit,
+		TArray<double>& Costs)
+	{
+		typedef TDijkstraSearch<MapT, uint32> FDijkstra;
+
+		// the same node may be asked for more than once, so each one maps to every destination it stands for
+		TMap<uint32, TArray<int32>> DestinationLookup;
+		for (int32 DestinationIndex = 0; DestinationIndex < Destinations.Num(); ++DestinationIndex) {
+			if (SearchMap.HasNode(Destinations[DestinationIndex])) {
+				DestinationLookup.FindOrAdd(Destinations[DestinationIndex]).Add(DestinationIndex);
+			}
+		}
+		if (DestinationLookup.IsEmpty()) {
+			return;
+		}
+
+		ParallelFor(Origins.Num(), [&](const int32 OriginIndex)
+		{
+			static thread_local typename FDijkstra::FSearchArena Arena;
+
+			const uint32 Origin = Origins[OriginIndex];
+			if (!SearchMap.HasNode(Origin)) {
+				return;
+			}
+
+			// each search only writes its own row (or column), so searches never touch the same entries
+			int32 NumUnsettled = DestinationLookup.Num();
+			FDijkstra::RunUntil(SearchMap, Origin, Arena, [&](const uint32 Location, const double Cost)
+			{
+				const TArray<int32>* DestinationIndices = DestinationLookup.Find(Location);
+				if (!DestinationIndices) {
+					return false;
+				}
+				for (const int32 DestinationIndex : *DestinationIndices) {
+					const int32 SourceIndex = bOriginsAreSources ? OriginIndex : DestinationIndex;
+					const int32 TargetIndex = bOriginsAreSources ? DestinationIndex : OriginIndex;
+					Costs[SourceIndex * NumTargets + TargetIndex] = Cost;
+				}
+				return --NumUnsettled == 0;
+			}, CostLimit);
+		});
+	}
+}
+
+void FNavGridCostMatrix::Build(const FNavGridFrozenGraph& Graph, const TConstArrayView<FInt64Vector3> Sources, const TConstArrayView<FInt64Vector3> Targets, const double CostLimit)
+{
+	NumSources = Sources.Num();
+	NumTargets = Targets.Num();
+	Costs.Init(-1.0, NumSources * NumTargets);
+
+	if (Costs.IsEmpty()) {
+		return;
+	}
+
+	// nodes that are not in the graph become InvalidNode, which neither side of a search ever has
+	const auto FindNodes = [&Graph](const TConstArrayView<FInt64Vector3> Indices)
+	{
+		TArray<uint32> Nodes;
+		Nodes.Reserve(Indices.Num());
+		for (const FInt64Vector3& Index : Indices) {
+			Nodes.Add(Graph.FindNode(Index));
+		}
+		return Nodes;
+	};
+	const TArray<uint32> SourceNodes = FindNodes(Sources);
+	const TArray<uint32> TargetNodes = FindNodes(Targets);
+
+	// a search settles every destination it needs in one go, so search from whichever side has fewer nodes
+	if (NumSources <= NumTargets) {
+		SearchFromEachOrigin(Graph, SourceNodes, TargetNodes, true, NumTargets, CostLimit, Costs);
+	}
+	else {
+		SearchFromEachOrigin(FNavGridFrozenReverseView(Graph), TargetNodes, SourceNodes, false, NumTargets, CostLimit, Costs);
+	}
+
+	UE_LOG(LogNavGridCostMatrix, Verbose, TEXT("Built %d x %d cost matrix with %d searches"), NumSources, NumTargets, FMath::Min(NumSources, NumTargets));
+}
+
+void FNavGridCostMatrix::Reset()
+{
+	NumSources = 0;
+	NumTargets = 0;
+	Costs.Reset();
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "MapData/NavGridFrozenGraph.h"
+
+/**
+ * @class FNavGridCostMatrix
+ * @brief Shortest path costs from every one of a set of source nodes to every one of a set of target nodes.
+ *
+ * Built without finding, reconstructing or smoothing any individual path: each search settles nodes outward
+ * from one source (or, through the reversed graph, one target) until every node on the other side has been
+ * reached, so the matrix takes min(sources, targets) searches rather than one per pair. The searches are
+ * independent, so they are spread across worker threads.
+ *
+ * Costs are measured in grid cells, and are the frozen graph's edge costs, so they agree with the cost limits
+ * of path queries.
+ */
+class FNavGridCostMatrix
+{
+public:
+	/**
+	 * @brief Replaces the contents of the matrix with the costs between two sets of nodes.
+	 *
+	 * @param Graph The graph to search; must not change until the build has finished
+	 * @param Sources The nodes paths start from; one row each
+	 * @param Targets The nodes paths end at; one column each
+	 * @param CostLimit Pairs that cost more than this are reported as unreachable, and searches stop expanding
+	 * nodes beyond it
+	 */
+	void Build(const FNavGridFrozenGraph& Graph, TConstArrayView<FInt64Vector3> Sources, TConstArrayView<FInt64Vector3> Targets, double CostLimit = TNumericLimits<double>::Max());
+
+	void Reset();
+
+	FORCEINLINE int32 GetNumSources() const { return NumSources; }
+	FORCEINLINE int32 GetNumTargets() const { return NumTargets; }
+
+	/**
+	 * @return The cost of the shortest path from a source to a target, or a negative value if there is none
+	 * within the cost limit (or either node is not in the graph)
+	 */
+	FORCEINLINE double GetCost(const int32 SourceIndex, const int32 TargetIndex) const
+	{
+		return Costs[SourceIndex * NumTargets + TargetIndex];
+	}
+
+	/**
+	 * @return Every cost in the matrix, one row per source, laid out as for GetCost
+	 */
+	FORCEINLINE const TArray<double>& GetCosts() const { return Costs; }
+
+private:
+	int32 NumSources = 0;
+	int32 NumTargets = 0;
+	TArray<double> Costs;
+};
@@ -0,0 +1,155 @@
+#include "NavGridFlowField.h"
+
+#include "DijkstraSearch.h"
+#include "GridNavigatorConfig.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogNavGridFlowField, Log, All)
+
+void FNavGridFlowField::Build(const FNavGridFrozenGraph& Graph, const FInt64Vector3& NewGoal, const uint32 NewGraphVersion)
+{
+	typedef TDijkstraSearch<FNavGridFrozenReverseView, uint32> FReverseDijkstra;
+	static thread_local FReverseDijkstra::FSearchArena Arena;
+
+	Goal = NewGoal;
+	GraphVersion = NewGraphVersion;
+	Cells.Reset();
+	CellLookup.Reset();
+
+	const uint32 GoalNode = Graph.FindNode(Goal);
+	if (GoalNode == FNavGridFrozenGraph::InvalidNode) {
+		return;
+	}
+
+	// searching the reversed graph from the goal makes each node's parent its next step towards the goal
+	FReverseDijkstra::Run(FNavGridFrozenReverseView(Graph), GoalNode, Arena);
+
+	TArray<int32> SlotToCell;
+	SlotToCell.Init(INDEX_NONE, Arena.Num());
+	Cells.Reserve(Arena.Num());
+	CellLookup.Reserve(Arena.Num());
+
+	for (int32 Slot = 0; Slot < Arena.Num(); ++Slot) {
+		const auto& Record = Arena[Slot];
+		if (!Record.bClosed) {
+			continue;
+		}
+		const FInt64Vector3 Location = Graph.GetNodeIndex(Record.Location);
+		SlotToCell[Slot] = Cells.Add({ Location, Record.ParentSlot, Record.GCost });
+		CellLookup.Add(Location, SlotToCell[Slot]);
+	}
+
+	for (auto& Cell : Cells) {
+		if (Cell.NextIndex != INDEX_NONE) {
+			Cell.NextIndex = SlotToCell[Cell.NextIndex];
+			check(Cell.NextIndex != INDEX_NONE);
+		}
+	}
+
+	UE_LOG(LogNavGridFlowField, Verbose, TEXT("Built flow field towards %s covering %d nodes"), *Goal.ToString(), Cells.Num());
+}
+
+bool FNavGridFlowField::GetNextHop(const FInt64Vector3& Location, FInt64Vector3& OutNextHop) const
+{
+	const int32* CellIndex = CellLookup.Find(Location);
+	if (!CellIndex) {
+		return false;
+	}
+
+	const int32 NextIndex = Cells[*CellIndex].NextIndex;
+	OutNextHop = NextIndex != INDEX_NONE ? Cells[NextIndex].Location : Location;
+	return true;
+}
+
+FVector FNavGridFlowField::GetDirection(const FInt64Vector3& Location) const
+{
+	FInt64Vector3 NextHop;
+	if (!GetNextHop(Location, NextHop) || NextHop == Location) {
+		return FVector::ZeroVector;
+	}
+
+	const FVector Offset = GridNavigatorConfig::GridIndexToWorld(NextHop) - GridNavigatorConfig::GridIndexToWorld(Location);
+	return Offset.GetSafeNormal();
+}
+
+double FNavGridFlowField::GetCostToGoal(const FInt64Vector3& Location) const
+{
+	const int32* CellIndex = CellLookup.Find(Location);
+	return CellIndex ? Cells[*CellIndex].CostToGoal : -1.0;
+}
+
+TArray<FInt64Vector3> FNavGridFlowField::TracePath(const FInt64Vector3& Start) const
+{
+	TArray<FInt64Vector3> Result;
+	const int32* CellIndex = CellLookup.Find(Start);
+	if (!CellIndex) {
+		return Result;
+	}
+
+	for (int32 CurrIndex = *CellIndex; CurrIndex != INDEX_NONE; CurrIndex = Cells[CurrIndex].NextIndex) {
+		Result.Push(Cells[CurrIndex].Location);
+	}
+	return Result;
+}
+
+FNavGridFlowFieldCache::FNavGridFlowFieldCache(const int32 NewCapacity) : Capacity(FMath::Max(NewCapacity, 0)) {}
+
+TSharedRef<const FNavGridFlowField> FNavGridFlowFieldCache::FindOrBuild(const FNavGridFrozenGraph& Graph, const FInt64Vector3& Goal, const uint32 GraphVersion)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (const FEntry* Existing = Entries.Find(Goal)) {
+			if (Existing->Field->GetGraphVersion() == GraphVersion) {
+				return Existing->Field;
+			}
+		}
+	}
+
+	// build outside the lock, so lookups for other goals are not held up; two threads asking for the same new
+	// goal at once may both build it, and the last one to finish is kept
+	const TSharedRef<FNavGridFlowField> Field = MakeShared<FNavGridFlowField>();
+	Field->Build(Graph, Goal, GraphVersion);
+
+	FScopeLock ScopeLock(&Lock);
+	if (Capacity == 0) {
+		return Field;
+	}
+
+	if (!Entries.Contains(Goal) && Entries.Num() >= Capacity) {
+		EvictOldest();
+	}
+	Entries.Add(Goal, { Field, NextBuildOrder++ });
+	return Field;
+}
+
+void FNavGridFlowFieldCache::SetCapacity(const int32 NewCapacity)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	Capacity = FMath::Max(NewCapacity, 0);
+	while (Entries.Num() > Capacity) {
+		EvictOldest();
+	}
+}
+
+void FNavGridFlowFieldCache::Clear()
+{
+	FScopeLock ScopeLock(&Lock);
+	Entries.Empty();
+}
+
+void FNavGridFlowFieldCache::EvictOldest()
+{
+	const FInt64Vector3* OldestGoal = nullptr;
+	uint64 OldestBuildOrder = MAX_uint64;
+	for (const auto& [Goal, Entry] : Entries) {
+		if (Entry.BuildOrder < OldestBuildOrder) {
+			OldestGoal = &Goal;
+			OldestBuildOrder = Entry.BuildOrder;
+		}
+	}
+
+	if (OldestGoal) {
+		const FInt64Vector3 GoalToRemove = *OldestGoal;
+		Entries.Remove(GoalToRemove);
+	}
+}
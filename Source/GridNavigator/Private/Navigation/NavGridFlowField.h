@@ -0,0 +1,120 @@
+#pragma once
+
+#include "MapData/NavGridFrozenGraph.h"
+
+/**
+ * @class FNavGridFlowField
+ * @brief The next step towards a single goal from every grid node that can reach it.
+ *
+ * Built by one Dijkstra search from the goal over the reversed graph, so any number of agents heading to the
+ * same goal share a single search, and each of them can look up its next step in constant time. Following the
+ * next steps from any node traces out a shortest path to the goal.
+ *
+ * Costs are measured in grid cells, and are the frozen graph's edge costs, so they agree with the cost limits
+ * of path queries.
+ */
+class FNavGridFlowField
+{
+public:
+	/**
+	 * @brief Replaces the contents of the field with the next steps towards Goal.
+	 *
+	 * @param Graph The graph to search
+	 * @param NewGoal The node every step leads towards; the field is left empty if it is not in Graph
+	 * @param NewGraphVersion Version of Graph the field is built from (see ANavigationGridData::GetGraphVersion)
+	 */
+	void Build(const FNavGridFrozenGraph& Graph, const FInt64Vector3& NewGoal, uint32 NewGraphVersion);
+
+	FORCEINLINE const FInt64Vector3& GetGoal() const { return Goal; }
+	FORCEINLINE uint32 GetGraphVersion() const { return GraphVersion; }
+	FORCEINLINE int32 Num() const { return Cells.Num(); }
+	FORCEINLINE bool Contains(const FInt64Vector3& Location) const { return CellLookup.Contains(Location); }
+
+	/**
+	 * @brief Looks up the next node on the shortest path from Location to the goal.
+	 *
+	 * @param Location The node to step from
+	 * @param OutNextHop Receives the next node; the goal itself maps to the goal
+	 * @return \c true if Location can reach the goal; \c false otherwise
+	 */
+	bool GetNextHop(const FInt64Vector3& Location, FInt64Vector3& OutNextHop) const;
+
+	/**
+	 * @return World-space unit direction from Location towards its next node, or a zero vector if Location is
+	 * the goal or cannot reach it
+	 */
+	FVector GetDirection(const FInt64Vector3& Location) const;
+
+	/**
+	 * @return The cost of the shortest path from Location to the goal, or a negative value if it cannot reach it
+	 */
+	double GetCostToGoal(const FInt64Vector3& Location) const;
+
+	/**
+	 * @return The shortest path from Start to the goal, read from the field, or an empty array if Start cannot
+	 * reach the goal
+	 */
+	TArray<FInt64Vector3> TracePath(const FInt64Vector3& Start) const;
+
+private:
+	struct FCell
+	{
+		FInt64Vector3 Location;
+
+		// index into Cells of the next node towards the goal; INDEX_NONE for the goal itself
+		int32 NextIndex;
+		double CostToGoal;
+	};
+
+	FInt64Vector3 Goal = FInt64Vector3::ZeroValue;
+	uint32 GraphVersion = 0;
+
+	TArray<FCell> Cells;
+	TMap<FInt64Vector3, int32> CellLookup;
+};
+
+/**
+ * @class FNavGridFlowFieldCache
+ * @brief A bounded, thread-safe set of flow fields, keyed by goal node.
+ *
+ * Fields built from an older version of the graph are never returned; they are rebuilt on their next lookup.
+ * Fields are shared with callers, so a field that has been evicted stays valid for as long as it is held.
+ */
+class FNavGridFlowFieldCache
+{
+public:
+	explicit FNavGridFlowFieldCache(int32 NewCapacity);
+
+	/**
+	 * @brief Returns the flow field towards a goal, building it if no up-to-date field is cached.
+	 *
+	 * @param Graph The graph to search if the field has to be built
+	 * @param Goal The node the field should lead towards
+	 * @param GraphVersion Current version of Graph
+	 * @return The flow field; empty if Goal is not in Graph
+	 */
+	TSharedRef<const FNavGridFlowField> FindOrBuild(const FNavGridFrozenGraph& Graph, const FInt64Vector3& Goal, uint32 GraphVersion);
+
+	/**
+	 * @brief Changes the maximum number of cached fields, evicting the oldest fields if needed; 0 disables caching.
+	 */
+	void SetCapacity(int32 NewCapacity);
+
+	void Clear();
+
+private:
+	struct FEntry
+	{
+		TSharedRef<const FNavGridFlowField> Field;
+
+		// order in which fields were built, used to pick the oldest one to evict
+		uint64 BuildOrder;
+	};
+
+	void EvictOldest();
+
+	mutable FCriticalSection Lock;
+	TMap<FInt64Vector3, FEntry> Entries;
+	int32 Capacity;
+	uint64 NextBuildOrder = 0;
+};
@@ -0,0 +1,55 @@
+#include "NavGridIncrementalPath.h"
+
+#include "GridNavigatorConfig.h"
+#include "NavigationGridData.h"
+#include "NavGridChangeJournal.h"
+#include "NavGridPathfinder.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogNavGridIncrementalPath, Log, All)
+
+FNavGridIncrementalPath::FNavGridIncrementalPath(const ANavigationGridData& NewNavData, const FVector& Goal)
+	: NavData(&NewNavData), GoalIndex(GridNavigatorConfig::WorldToGridIndex(Goal)) {}
+
+bool FNavGridIncrementalPath::Update(const FVector& CurrentLocation, TArray<FVector>& OutPoints)
+{
+	check(IsInGameThread());
+
+	const ANavigationGridData* Data = NavData.Get();
+	const TSharedPtr<const FNavGridLevel> CurrentLevel = Data ? Data->GetLevelData() : nullptr;
+	if (!CurrentLevel) {
+		UE_LOG(LogNavGridIncrementalPath, Error, TEXT("Tried to update an incremental path without valid navigation data"));
+		OutPoints.Reset();
+		return false;
+	}
+
+	const FNavGridAdjacencyList& Map = CurrentLevel->Map;
+	const FInt64Vector3 StartIndex = GridNavigatorConfig::WorldToGridIndex(CurrentLocation);
+
+	// a newer snapshot has been published; move the planner onto it and repair what changed in between
+	if (Planner && CurrentLevel != Level) {
+		TArray<FInt64Vector3> ChangedNodes;
+		if (Data->GetChangeJournal()->GetChangedNodesSince(Level->Version, CurrentLevel->Version, ChangedNodes)) {
+			Planner->SetMaps(Map, FNavGridReverseAdjacencyView(Map));
+			Planner->SetStart(StartIndex);
+			Planner->NotifyNodesChanged(ChangedNodes);
+		}
+		else {
+			UE_LOG(LogNavGridIncrementalPath, Verbose, TEXT("Graph changes since version %u are no longer recorded; replanning from scratch"), Level->Version);
+			Planner.Reset();
+		}
+	}
+
+	if (!Planner) {
+		Planner = MakeUnique<FPlanner>(Map, FNavGridReverseAdjacencyView(Map), StartIndex, GoalIndex);
+	}
+	Level = CurrentLevel;
+
+	Planner->SetStart(StartIndex);
+	if (!Planner->Plan()) {
+		OutPoints.Reset();
+		return false;
+	}
+
+	OutPoints = FNavGridPathfinder::ProcessPath(Map, Planner->GetPath());
+	return !OutPoints.IsEmpty();
+}
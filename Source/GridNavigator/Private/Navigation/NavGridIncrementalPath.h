@@ -0,0 +1,45 @@
+#pragma once
+
+#include "DStarLiteNavigator.h"
+#include "MapData/NavGridAdjacencyList.h"
+#include "MapData/NavGridLevel.h"
+
+class ANavigationGridData;
+
+/**
+ * @class FNavGridIncrementalPath
+ * @brief Keeps a moving agent's path to a fixed goal up to date as the navigation grid is rebuilt.
+ *
+ * Wraps a D* Lite planner over a navigation data's graph. Each update catches the planner up with the graph
+ * changes recorded since the previous update, so edits near the agent (eg. destructible geometry) only cost
+ * a repair of the affected part of the search rather than a new search.
+ */
+class FNavGridIncrementalPath
+{
+public:
+	FNavGridIncrementalPath(const ANavigationGridData& NewNavData, const FVector& Goal);
+
+	/**
+	 * @brief Moves the start of the path to the agent's location, applies any graph changes, and replans.
+	 *
+	 * @param CurrentLocation The agent's current world location; snapped to the grid
+	 * @param OutPoints Receives the path points from CurrentLocation to the goal, or an empty array if there is no path
+	 * @return \c true if a path was found; \c false otherwise
+	 *
+	 * @note Must be called on the game thread.
+	 */
+	bool Update(const FVector& CurrentLocation, TArray<FVector>& OutPoints);
+
+	// number of nodes processed by the most recent replan
+	FORCEINLINE int32 GetNumExpansions() const { return Planner ? Planner->GetNumExpansions() : 0; }
+
+private:
+	typedef TDStarLitePlanner<FNavGridAdjacencyList, FNavGridReverseAdjacencyView, FInt64Vector3> FPlanner;
+
+	TWeakObjectPtr<const ANavigationGridData> NavData;
+	FInt64Vector3 GoalIndex;
+
+	// snapshot the planner is synchronized with; pinned, since the planner reads its map between updates
+	TSharedPtr<const FNavGridLevel> Level;
+	TUniquePtr<FPlanner> Planner;
+};
@@ -0,0 +1,72 @@
+#include "NavGridMovementRange.h"
+
+#include "DijkstraSearch.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogNavGridMovementRange, Log, All)
+
+void FNavGridMovementRange::Build(const FNavGridFrozenGraph& Graph, const FInt64Vector3& Origin, const double CostLimit)
+{
+	typedef TDijkstraSearch<FNavGridFrozenGraph, uint32> FRangeDijkstra;
+	static thread_local FRangeDijkstra::FSearchArena Arena;
+
+	Reset();
+	const uint32 OriginNode = Graph.FindNode(Origin);
+	if (OriginNode == FNavGridFrozenGraph::InvalidNode || CostLimit < 0.0) {
+		return;
+	}
+
+	FRangeDijkstra::Run(Graph, OriginNode, Arena, CostLimit);
+
+	// keep only the settled records, remapping their parent slots onto the compacted entries
+	TArray<int32> SlotToEntry;
+	SlotToEntry.Init(INDEX_NONE, Arena.Num());
+	Entries.Reserve(Arena.Num());
+	EntryLookup.Reserve(Arena.Num());
+
+	for (int32 Slot = 0; Slot < Arena.Num(); ++Slot) {
+		const auto& Record = Arena[Slot];
+		if (!Record.bClosed) {
+			continue;
+		}
+		const FInt64Vector3 Location = Graph.GetNodeIndex(Record.Location);
+		SlotToEntry[Slot] = Entries.Add({ Location, Record.ParentSlot, Record.GCost });
+		EntryLookup.Add(Location, SlotToEntry[Slot]);
+	}
+
+	// a settled record's parent is always settled too, so every parent slot has an entry by now
+	for (auto& Entry : Entries) {
+		if (Entry.ParentIndex != INDEX_NONE) {
+			Entry.ParentIndex = SlotToEntry[Entry.ParentIndex];
+			check(Entry.ParentIndex != INDEX_NONE);
+		}
+	}
+
+	UE_LOG(LogNavGridMovementRange, Verbose, TEXT("Found %d nodes within cost %0.2f"), Entries.Num(), CostLimit);
+}
+
+void FNavGridMovementRange::Reset()
+{
+	Entries.Reset();
+	EntryLookup.Reset();
+}
+
+double FNavGridMovementRange::GetCost(const FInt64Vector3& Location) const
+{
+	const int32* EntryIndex = EntryLookup.Find(Location);
+	return EntryIndex ? Entries[*EntryIndex].Cost : -1.0;
+}
+
+TArray<FInt64Vector3> FNavGridMovementRange::GetPathTo(const FInt64Vector3& Location) const
+{
+	TArray<FInt64Vector3> Result;
+	const int32* EntryIndex = EntryLookup.Find(Location);
+	if (!EntryIndex) {
+		return Result;
+	}
+
+	for (int32 CurrIndex = *EntryIndex; CurrIndex != INDEX_NONE; CurrIndex = Entries[CurrIndex].ParentIndex) {
+		Result.Push(Entries[CurrIndex].Location);
+	}
+	Algo::Reverse(Result);
+	return Result;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "MapData/NavGridFrozenGraph.h"
+
+/**
+ * @class FNavGridMovementRange
+ * @brief Every grid node reachable from an origin within a cost limit, with its cost and predecessor.
+ *
+ * Built by a single bounded Dijkstra search, so one range replaces a point-to-point query per candidate
+ * destination. The shortest path to any node in range can be read back from the stored predecessors in time
+ * proportional to its length.
+ *
+ * Costs are measured in grid cells, and are the frozen graph's edge costs, so they agree with the cost limits
+ * of path queries.
+ */
+class FNavGridMovementRange
+{
+public:
+	struct FEntry
+	{
+		FInt64Vector3 Location;
+
+		// index into the range's entries of the node this one is reached from; INDEX_NONE for the origin
+		int32 ParentIndex;
+		double Cost;
+	};
+
+	/**
+	 * @brief Replaces the contents of the range with every node reachable from Origin within CostLimit.
+	 *
+	 * @param Graph The graph to search
+	 * @param Origin The node all costs are measured from; the range is left empty if it is not in Graph
+	 * @param CostLimit Nodes that cost more than this to reach are left out of the range
+	 */
+	void Build(const FNavGridFrozenGraph& Graph, const FInt64Vector3& Origin, double CostLimit);
+
+	void Reset();
+
+	FORCEINLINE int32 Num() const { return Entries.Num(); }
+	FORCEINLINE bool IsEmpty() const { return Entries.IsEmpty(); }
+	FORCEINLINE bool Contains(const FInt64Vector3& Location) const { return EntryLookup.Contains(Location); }
+
+	/**
+	 * @return All nodes in range, in no particular order; the origin is always the first entry
+	 */
+	FORCEINLINE const TArray<FEntry>& GetEntries() const { return Entries; }
+
+	/**
+	 * @return The cost to reach Location, or a negative value if it is not in range
+	 */
+	double GetCost(const FInt64Vector3& Location) const;
+
+	/**
+	 * @return The shortest path from the origin to Location, or an empty array if it is not in range
+	 */
+	TArray<FInt64Vector3> GetPathTo(const FInt64Vector3& Location) const;
+
+private:
+	TArray<FEntry> Entries;
+	TMap<FInt64Vector3, int32> EntryLookup;
+};
@@ -0,0 +1,161 @@
+#include "NavGridPathCache.h"
+
+#include "GridNavigatorStats.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogNavGridPathCache, Log, All)
+
+FNavGridPathCache::FNavGridPathCache(const int32 NewCapacity) : Capacity(FMath::Max(NewCapacity, 0)) {}
+
+bool FNavGridPathCache::Find(const FNavGridPathCacheKey& Key, TArray<FVector>& OutPoints)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const int32* EntryIndex = EntryLookup.Find(Key);
+	if (!EntryIndex) {
+		++Stats.Misses;
+		INC_DWORD_STAT(STAT_GridNavigator_PathCacheMisses);
+		return false;
+	}
+
+	Unlink(*EntryIndex);
+	LinkAtHead(*EntryIndex);
+	OutPoints = Entries[*EntryIndex].Points;
+
+	++Stats.Hits;
+	INC_DWORD_STAT(STAT_GridNavigator_PathCacheHits);
+	return true;
+}
+
+void FNavGridPathCache::Add(const FNavGridPathCacheKey& Key, const TArray<FVector>& Points)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	// the graph was rebuilt while this query was being searched, so its result may already be out of date
+	if (Capacity == 0 || Key.GraphVersion != GraphVersion) {
+		return;
+	}
+
+	if (const int32* ExistingIndex = EntryLookup.Find(Key)) {
+		FEntry& Existing = Entries[*ExistingIndex];
+		Existing.Points = Points;
+		Unlink(*ExistingIndex);
+		LinkAtHead(*ExistingIndex);
+		return;
+	}
+
+	if (Entries.Num() >= Capacity) {
+		EvictLeastRecentlyUsed();
+	}
+
+	const int32 NewIndex = Entries.Add({ Key, Points, INDEX_NONE, INDEX_NONE });
+	EntryLookup.Add(Key, NewIndex);
+	LinkAtHead(NewIndex);
+}
+
+void FNavGridPathCache::SetGraphVersion(const uint32 NewGraphVersion)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	GraphVersion = NewGraphVersion;
+	Entries.Empty();
+	EntryLookup.Empty();
+	Head = INDEX_NONE;
+	Tail = INDEX_NONE;
+}
+
+void FNavGridPathCache::SetCapacity(const int32 NewCapacity)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	Capacity = FMath::Max(NewCapacity, 0);
+	while (Entries.Num() > Capacity) {
+		EvictLeastRecentlyUsed();
+	}
+}
+
+void FNavGridPathCache::Clear()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	Entries.Empty();
+	EntryLookup.Empty();
+	Head = INDEX_NONE;
+	Tail = INDEX_NONE;
+}
+
+FNavGridPathCache::FStats FNavGridPathCache::GetStats() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Stats;
+}
+
+void FNavGridPathCache::Unlink(const int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	if (Entry.Prev != INDEX_NONE) {
+		Entries[Entry.Prev].Next = Entry.Next;
+	}
+	else {
+		Head = Entry.Next;
+	}
+	if (Entry.Next != INDEX_NONE) {
+		Entries[Entry.Next].Prev = Entry.Prev;
+	}
+	else {
+		Tail = Entry.Prev;
+	}
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = INDEX_NONE;
+}
+
+void FNavGridPathCache::LinkAtHead(const int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = Head;
+	if (Head != INDEX_NONE) {
+		Entries[Head].Prev = EntryIndex;
+	}
+	Head = EntryIndex;
+	if (Tail == INDEX_NONE) {
+		Tail = EntryIndex;
+	}
+}
+
+void FNavGridPathCache::RemoveEntry(const int32 EntryIndex)
+{
+	Unlink(EntryIndex);
+	EntryLookup.Remove(Entries[EntryIndex].Key);
+
+	// move the last entry into the freed slot, and repoint everything that referred to it
+	const int32 LastIndex = Entries.Num() - 1;
+	if (EntryIndex != LastIndex) {
+		Entries.Swap(EntryIndex, LastIndex);
+		FEntry& Moved = Entries[EntryIndex];
+		EntryLookup[Moved.Key] = EntryIndex;
+		if (Moved.Prev != INDEX_NONE) {
+			Entries[Moved.Prev].Next = EntryIndex;
+		}
+		else {
+			Head = EntryIndex;
+		}
+		if (Moved.Next != INDEX_NONE) {
+			Entries[Moved.Next].Prev = EntryIndex;
+		}
+		else {
+			Tail = EntryIndex;
+		}
+	}
+	Entries.Pop(false);
+}
+
+void FNavGridPathCache::EvictLeastRecentlyUsed()
+{
+	if (Tail == INDEX_NONE) {
+		return;
+	}
+	RemoveEntry(Tail);
+
+	++Stats.Evictions;
+	INC_DWORD_STAT(STAT_GridNavigator_PathCacheEvictions);
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "GridNavigatorTypes.h"
+
+/**
+ * @brief Identifies a cacheable pathfinding query.
+ *
+ * Queries are matched on the grid cells they start and end in rather than on exact world positions, since
+ * the pathfinder snaps both endpoints to the grid before searching. Of the query's filter, only its path
+ * smoothing affects the points a grid query produces, so that is all the key keeps of it.
+ */
+struct FNavGridPathCacheKey
+{
+	FInt64Vector3 StartIndex;
+	FInt64Vector3 GoalIndex;
+	EGridNavigatorPathSmoothing Smoothing;
+	EGridNavigatorSearchMode SearchMode;
+	double CostLimit;
+	uint32 GraphVersion;
+
+	bool operator==(const FNavGridPathCacheKey& Rhs) const
+	{
+		return StartIndex == Rhs.StartIndex
+			&& GoalIndex == Rhs.GoalIndex
+			&& Smoothing == Rhs.Smoothing
+			&& SearchMode == Rhs.SearchMode
+			&& CostLimit == Rhs.CostLimit
+			&& GraphVersion == Rhs.GraphVersion;
+	}
+
+	friend uint32 GetTypeHash(const FNavGridPathCacheKey& Key)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Key.StartIndex), GetTypeHash(Key.GoalIndex));
+		Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(Key.Smoothing)));
+		Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(Key.SearchMode)));
+		Hash = HashCombine(Hash, GetTypeHash(Key.CostLimit));
+		return HashCombine(Hash, GetTypeHash(Key.GraphVersion));
+	}
+};
+
+/**
+ * @class FNavGridPathCache
+ * @brief A bounded, thread-safe LRU cache of finished path points, keyed by query.
+ *
+ * Every key carries the graph version it was computed against, and lookups only match the current version,
+ * so a query that was searched on an older graph can never be returned after a rebuild, even if it is stored
+ * after the rebuild has finished. Entries from older versions can never be hit again, so the cache is cleared
+ * whenever a new version is published rather than leaving them to age out. The navigation data owns the version
+ * counter, and tells the cache about each version it publishes.
+ */
+class FNavGridPathCache
+{
+public:
+	struct FStats
+	{
+		uint64 Hits = 0;
+		uint64 Misses = 0;
+		uint64 Evictions = 0;
+	};
+
+	explicit FNavGridPathCache(int32 NewCapacity);
+
+	/**
+	 * @brief Looks up the path points stored for a query and marks the entry as most recently used.
+	 *
+	 * @param Key The query to look up
+	 * @param OutPoints Receives the stored points on a hit; may be empty if the query is known to have no path
+	 * @return \c true on a cache hit; \c false otherwise
+	 */
+	bool Find(const FNavGridPathCacheKey& Key, TArray<FVector>& OutPoints);
+
+	/**
+	 * @brief Stores the result of a query, evicting the least recently used entry if the cache is full.
+	 *
+	 * @param Key The query the points were found for; ignored if its graph version is no longer current
+	 * @param Points The finished path points, or an empty array if no path exists
+	 */
+	void Add(const FNavGridPathCacheKey& Key, const TArray<FVector>& Points);
+
+	/**
+	 * @brief Moves the cache on to a newly published graph version (see ANavigationGridData::GetGraphVersion),
+	 * dropping every stored entry, since entries from older versions can never be hit again.
+	 */
+	void SetGraphVersion(uint32 NewGraphVersion);
+
+	/**
+	 * @brief Changes the maximum number of stored entries, evicting entries if needed; 0 disables caching.
+	 */
+	void SetCapacity(int32 NewCapacity);
+
+	void Clear();
+
+	FStats GetStats() const;
+
+private:
+	struct FEntry
+	{
+		FNavGridPathCacheKey Key;
+		TArray<FVector> Points;
+
+		// neighbors in the recency list, as indices into Entries
+		int32 Prev;
+		int32 Next;
+	};
+
+	void Unlink(int32 EntryIndex);
+	void LinkAtHead(int32 EntryIndex);
+	void RemoveEntry(int32 EntryIndex);
+	void EvictLeastRecentlyUsed();
+
+	mutable FCriticalSection Lock;
+
+	// entries are stored densely, and removed by swapping the last entry into their slot
+	TArray<FEntry> Entries;
+	TMap<FNavGridPathCacheKey, int32> EntryLookup;
+
+	// most and least recently used entries
+	int32 Head = INDEX_NONE;
+	int32 Tail = INDEX_NONE;
+
+	int32 Capacity;
+
+	// the version of the most recently published snapshot; results for any other version are not stored
+	uint32 GraphVersion = 0;
+	FStats Stats;
+};
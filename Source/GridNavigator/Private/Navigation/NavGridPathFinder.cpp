@@ -1,23 +1,16 @@
 #include "NavGridPathFinder.h"
 
 #include "AStarNavigator.h"
+#include "BidirectionalAStarNavigator.h"
+#include "GridDistance.h"
+#include "JumpPointNavigator.h"
+#include "NavGridFlowField.h"
 #include "GridNavigatorConfig.h"
-#include "MapData/NavGridAdjacencyList.h"
+#include "MapData/NavGridLevel.h"
 
-namespace UE::Math
-{
-	inline double Distance(const FInt64Vector3& Lhs, const FInt64Vector3& Rhs)
-	{
-		const FInt64Vector3 Diff = Rhs - Lhs;
-		const double XSquared = static_cast<double>(Diff.X) * static_cast<double>(Diff.X);
-		const double YSquared = static_cast<double>(Diff.Y) * static_cast<double>(Diff.Y);
-		const double ZSquared = static_cast<double>(Diff.Z) * static_cast<double>(Diff.Z);
-		return FMath::Sqrt(XSquared + YSquared + ZSquared);
-	}
-}
-
-TArray<FVector> FNavGridPathfinder::FindPath(const UWorld& WorldRef, const FNavGridAdjacencyList& Grid, const FVector& First, const FVector& Final)
+TArray<FVector> FNavGridPathfinder::FindPath(const FNavGridLevel& Level, const FVector& First, const FVector& Final, const EGridNavigatorSearchMode SearchMode, const double CostLimit, const EGridNavigatorPathSmoothing Smoothing)
 {
+	const FNavGridAdjacencyList& Grid = Level.Map;
 	FInt64Vector3 FirstIndex = GridNavigatorConfig::WorldToGridIndex(First);
 	FInt64Vector3 FinalIndex = GridNavigatorConfig::WorldToGridIndex(Final);
 	
@@ -26,20 +19,90 @@ TArray<FVector> FNavGridPathfinder::FindPath(const UWorld& WorldRef, const FNavG
         return {};
     }
 
-	// Call the A* algorithm
-	TAStarNavigator<FNavGridAdjacencyList, FInt64Vector3> Navigator;
-	Navigator.Heuristic = [](const FInt64Vector3& Lhs, const FInt64Vector3& Rhs) -> double
-	{
-		const double YComponent = static_cast<double>(Rhs.Y - Lhs.Y);
-		const double XComponent = static_cast<double>(Rhs.X - Lhs.X);
-		return FMath::Sqrt(XComponent*XComponent + YComponent*YComponent);
-	};
-
-    TArray<FInt64Vector> PathNodes = Navigator.Navigate(Grid, FirstIndex, FinalIndex);
-    if (PathNodes.Num() == 0) {
+	// a search between components would have to exhaust the start's component before giving up
+	if (!Level.Components.AreConnected(FirstIndex, FinalIndex)) {
+		return {};
+	}
+
+	// the other modes measure their paths in the adjacency list's costs, which the frozen graph rounds up, so
+	// anything they prune by the limit would also have failed the exact check below
+	TArray<FInt64Vector> PathNodes;
+	if (SearchMode == EGridNavigatorSearchMode::Hierarchical) {
+		PathNodes = FindHierarchicalPath(Level, First, Final, CostLimit).RefineAll();
+	}
+	else if (SearchMode == EGridNavigatorSearchMode::Bidirectional) {
+		TBidirectionalAStarNavigator<FNavGridAdjacencyList, FNavGridReverseAdjacencyView, FInt64Vector3> Navigator;
+		Navigator.CostLimit = CostLimit;
+		PathNodes = Navigator.Navigate(Grid, FNavGridReverseAdjacencyView(Grid), FirstIndex, FinalIndex);
+	}
+	else if (SearchMode == EGridNavigatorSearchMode::JumpPoint) {
+		TJumpPointNavigator<FNavGridAdjacencyList, FInt64Vector3> Navigator;
+		Navigator.CostLimit = CostLimit;
+		PathNodes = Navigator.Navigate(Grid, FirstIndex, FinalIndex);
+	}
+	else {
+		// plain A* runs on the frozen copy of the grid, which is laid out for searching rather than editing
+		const FNavGridFrozenGraph& Graph = Level.Graph;
+		const uint32 FirstNode = Graph.FindNode(FirstIndex);
+		const uint32 FinalNode = Graph.FindNode(FinalIndex);
+		if (FirstNode == FNavGridFrozenGraph::InvalidNode || FinalNode == FNavGridFrozenGraph::InvalidNode) {
+			return {};
+		}
+
+		TAStarNavigator<FNavGridFrozenGraph, uint32, FNavGridFrozenHeuristic> Navigator;
+		Navigator.CostLimit = CostLimit;
+		Navigator.Heuristic = FNavGridFrozenHeuristic(Graph, Level.Landmarks, FinalNode);
+		for (const uint32 Node : Navigator.Navigate(Graph, FirstNode, FinalNode)) {
+			PathNodes.Add(Graph.GetNodeIndex(Node));
+		}
+	}
+
+	// only plain A* searches the frozen graph, so the other modes check the exact cost once they have found a path
+	if (SearchMode != EGridNavigatorSearchMode::AStar && GetPathCost(Level.Graph, PathNodes) > CostLimit) {
+		return {};
+	}
+
+    return ProcessPath(Grid, PathNodes, Smoothing);
+}
+
+FNavGridHierarchicalPath FNavGridPathfinder::FindHierarchicalPath(const FNavGridLevel& Level, const FVector& First, const FVector& Final, const double CostLimit)
+{
+	const FInt64Vector3 FirstIndex = GridNavigatorConfig::WorldToGridIndex(First);
+	const FInt64Vector3 FinalIndex = GridNavigatorConfig::WorldToGridIndex(Final);
+	if (!Level.Components.AreConnected(FirstIndex, FinalIndex)) {
+		return {};
+	}
+	return Level.Hierarchy.FindPath(Level.Map, FirstIndex, FinalIndex, CostLimit);
+}
+
+bool FNavGridPathfinder::IsBeyondCostLimit(const FNavGridLevel& Level, const FVector& First, const FVector& Final, const double CostLimit)
+{
+	const FNavGridFrozenGraph& Graph = Level.Graph;
+	const uint32 FirstNode = Graph.FindNode(GridNavigatorConfig::WorldToGridIndex(First));
+	const uint32 FinalNode = Graph.FindNode(GridNavigatorConfig::WorldToGridIndex(Final));
+	if (FirstNode == FNavGridFrozenGraph::InvalidNode || FinalNode == FNavGridFrozenGraph::InvalidNode) {
+		return false;
+	}
+	return FNavGridFrozenHeuristic(Graph, Level.Landmarks, FinalNode).Estimate(FirstNode, FinalNode) > CostLimit;
+}
+
+TArray<FVector> FNavGridPathfinder::FollowFlowField(const FNavGridAdjacencyList& Grid, const FNavGridFlowField& FlowField, const FVector& First, const double CostLimit, const EGridNavigatorPathSmoothing Smoothing)
+{
+	const FInt64Vector3 FirstIndex = GridNavigatorConfig::WorldToGridIndex(First);
+	if (FlowField.GetCostToGoal(FirstIndex) > CostLimit) {
+		return {};
+	}
+	return ProcessPath(Grid, FlowField.TracePath(FirstIndex), Smoothing);
+}
+
+TArray<FVector> FNavGridPathfinder::ProcessPath(const FNavGridAdjacencyList& Grid, const TArray<FInt64Vector3>& InPathNodes, const EGridNavigatorPathSmoothing Smoothing)
+{
+    if (InPathNodes.Num() == 0) {
         return {};
     }
 
+	const TArray<FInt64Vector3> PathNodes = Smoothing == EGridNavigatorPathSmoothing::AnyAngle ? StringPull(Grid, InPathNodes) : InPathNodes;
+
     // Perform path smoothing and additional geometry processing as needed
     TArray<FVector> UnfilteredPath;
 	FVector PointA = GridNavigatorConfig::GridIndexToWorld(PathNodes[0]);
@@ -48,19 +111,9 @@ TArray<FVector> FNavGridPathfinder::FindPath(const UWorld& WorldRef, const FNavG
         const FVector PointB = GridNavigatorConfig::GridIndexToWorld(PathNodes[i]);
 
         if (PointA.Z != PointB.Z) {
-        	FVector TraceUpper = (PointA + PointB) / 2.0;
-        	FVector TraceLower = TraceUpper;
-        	TraceUpper.Z = FMath::Max(PointA.Z, PointB.Z) + 1.0;
-        	TraceLower.Z = FMath::Min(PointA.Z, PointB.Z) - 1.0;
-
-        	FHitResult TraceResult;
-        	FCollisionObjectQueryParams ObjectsToTrace(ECC_WorldStatic);
-        	WorldRef.LineTraceSingleByObjectType(TraceResult, TraceUpper, TraceLower, ObjectsToTrace);
-
-        	// trace should never miss (no gaps between nodes in a path)
-        	check(TraceResult.IsValidBlockingHit());
-
-        	UnfilteredPath.Add(TraceResult.Location);
+        	// the floor between nodes at different heights was traced when the edge was built
+        	const std::optional<NavGrid::FEdge> Edge = Grid.FindTraversableEdge(PathNodes[i - 1], PathNodes[i]);
+        	UnfilteredPath.Add(Edge ? Edge->GetMidpoint() : (PointA + PointB) / 2.0);
         }
 
         PointA = PointB;
@@ -89,3 +142,83 @@ TArray<FVector> FNavGridPathfinder::FindPath(const UWorld& WorldRef, const FNavG
     Path.Add(UnfilteredPath.Last());
     return Path;
 }
+
+double FNavGridPathfinder::GetPathCost(const FNavGridFrozenGraph& Graph, const TArray<FInt64Vector3>& PathNodes)
+{
+	if (PathNodes.IsEmpty()) {
+		return 0.0;
+	}
+
+	// summed in path order from the start, the same way A* accumulates them, so equal paths give equal costs
+	double Cost = 0.0;
+	uint32 PrevNode = Graph.FindNode(PathNodes[0]);
+	for (int32 NodeIndex = 1; NodeIndex < PathNodes.Num(); ++NodeIndex) {
+		const uint32 Node = Graph.FindNode(PathNodes[NodeIndex]);
+		const double EdgeCost = Graph.GetEdgeCost(PrevNode, Node);
+		if (EdgeCost < 0.0) {
+			return TNumericLimits<double>::Max();
+		}
+		Cost += EdgeCost;
+		PrevNode = Node;
+	}
+	return Cost;
+}
+
+TArray<FInt64Vector3> FNavGridPathfinder::StringPull(const FNavGridAdjacencyList& Grid, const TArray<FInt64Vector3>& PathNodes)
+{
+	if (PathNodes.Num() <= 2) {
+		return PathNodes;
+	}
+
+	// keep a node only once the next one can no longer be seen from the last node kept; consecutive kept nodes are
+	// then either in sight of each other or joined by one of the path's own edges (eg. across a slope)
+	TArray<FInt64Vector3> Result;
+	Result.Add(PathNodes[0]);
+	int32 Anchor = 0;
+	for (int32 NodeIndex = 1; NodeIndex < PathNodes.Num() - 1; ++NodeIndex) {
+		if (!HasLineOfSight(Grid, PathNodes[Anchor], PathNodes[NodeIndex + 1])) {
+			Result.Add(PathNodes[NodeIndex]);
+			Anchor = NodeIndex;
+		}
+	}
+	Result.Add(PathNodes.Last());
+	return Result;
+}
+
+bool FNavGridPathfinder::HasLineOfSight(const FNavGridAdjacencyList& Grid, const FInt64Vector3& From, const FInt64Vector3& To)
+{
+	if (From.Z != To.Z) {
+		return false;
+	}
+
+	const int64 NumX = FMath::Abs(To.X - From.X);
+	const int64 NumY = FMath::Abs(To.Y - From.Y);
+	const int64 SignX = To.X >= From.X ? 1 : -1;
+	const int64 SignY = To.Y >= From.Y ? 1 : -1;
+
+	FInt64Vector3 Current = From;
+	int64 StepsX = 0;
+	int64 StepsY = 0;
+	while (StepsX < NumX || StepsY < NumY) {
+		// compares how far along the line its next crossings of a vertical and a horizontal cell border are; both
+		// at once means the line passes exactly through a cell corner
+		const int64 Decision = (1 + 2 * StepsX) * NumY - (1 + 2 * StepsY) * NumX;
+		const int64 MoveX = Decision <= 0 ? SignX : 0;
+		const int64 MoveY = Decision >= 0 ? SignY : 0;
+
+		uint8 DirectEdgeMask = 0;
+		bool bHasNonDirectEdges = false;
+		if (!Grid.GetDirectEdgeMask(Current, DirectEdgeMask, bHasNonDirectEdges)) {
+			return false;
+		}
+		if ((DirectEdgeMask & (1 << NavGrid::GetDirectionIndex(MoveX, MoveY))) == 0) {
+			return false;
+		}
+
+		Current.X += MoveX;
+		Current.Y += MoveY;
+		StepsX += MoveX != 0;
+		StepsY += MoveY != 0;
+	}
+	return true;
+}
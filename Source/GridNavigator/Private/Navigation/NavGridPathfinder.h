@@ -1,10 +1,16 @@
 #pragma once
 
-#include "MapData/NavGridAdjacencyList.h"
+#include "GridNavigatorTypes.h"
+#include "MapData/NavGridLevel.h"
+
+class FNavGridFlowField;
 
 /**
  * @class FNavGridPathfinder
  * @brief Performs pathfinding on a navigation grid.
+ *
+ * Only reads the navigation data, never the world, so queries can run on any thread as long as the grid is
+ * not being rebuilt at the same time.
  **/
 class FNavGridPathfinder
 {
@@ -12,11 +18,95 @@ public:
 	/**
 	 * Finds a path between two nodes in the grid.
 	 * 
-	 * @param WorldRef A reference to the UWorld context object.
-	 * @param Grid The navigation grid to search through.
+	 * @param Level The navigation data to search through.
 	 * @param First The world position for the start of pathfinding.
 	 * @param Final The world position for the end of pathfinding.
+	 * @param SearchMode The search algorithm used to find the path through the grid.
+	 * @param CostLimit Paths that cost more than this, in grid cells, are treated as not found.
+	 * @param Smoothing How the path's grid nodes are reduced to path points.
 	 * @return A list of nodes representing the path from the First point to the Final point.
 	 */
-	static TArray<FVector> FindPath(const UWorld& WorldRef, const FNavGridAdjacencyList& Grid, const FVector& First, const FVector& Final);
+	static TArray<FVector> FindPath(const FNavGridLevel& Level, const FVector& First, const FVector& Final, EGridNavigatorSearchMode SearchMode = EGridNavigatorSearchMode::AStar, double CostLimit = TNumericLimits<double>::Max(), EGridNavigatorPathSmoothing Smoothing = EGridNavigatorPathSmoothing::RemoveCollinear);
+
+	/**
+	 * Searches the level's hierarchical graph for a path between two nodes in the grid, without refining it into
+	 * grid nodes. Callers can refine it one segment at a time (see FNavGridHierarchicalPath::RefineNextSegment), and
+	 * start following the first segment before the rest has been searched.
+	 *
+	 * @param Level The navigation data to search through. The path refers to it, so it must stay pinned (see
+	 * ANavigationGridData::GetLevelData) for as long as the path is refined.
+	 * @param First The world position for the start of pathfinding.
+	 * @param Final The world position for the end of pathfinding.
+	 * @param CostLimit Abstract paths that cost more than this, in grid cells, are not searched for.
+	 * @return The abstract path; invalid if either position is off the grid or there is no path between them.
+	 */
+	static FNavGridHierarchicalPath FindHierarchicalPath(const FNavGridLevel& Level, const FVector& First, const FVector& Final, double CostLimit = TNumericLimits<double>::Max());
+
+	/**
+	 * Checks whether every path between two nodes in the grid must cost more than a limit, without searching,
+	 * using the same lower bound that plain A* searches the frozen graph with. Lets queries give up before paying
+	 * for a search, or a flow field, that could only find a path too expensive to return.
+	 *
+	 * @param Level The navigation data to check.
+	 * @param First The world position for the start of pathfinding.
+	 * @param Final The world position for the end of pathfinding.
+	 * @param CostLimit The cost limit, in grid cells.
+	 * @return True if no path between the two positions is within the limit; false if one may be.
+	 */
+	static bool IsBeyondCostLimit(const FNavGridLevel& Level, const FVector& First, const FVector& Final, double CostLimit);
+
+	/**
+	 * Finds a path to a flow field's goal by following the field, without searching the grid again.
+	 *
+	 * @param Grid The grid the flow field was built from.
+	 * @param FlowField The flow field towards the end of pathfinding.
+	 * @param First The world position for the start of pathfinding.
+	 * @param CostLimit Paths that cost more than this, in grid cells, are treated as not found.
+	 * @param Smoothing How the path's grid nodes are reduced to path points.
+	 * @return A list of nodes representing the path from the First point to the flow field's goal.
+	 */
+	static TArray<FVector> FollowFlowField(const FNavGridAdjacencyList& Grid, const FNavGridFlowField& FlowField, const FVector& First, double CostLimit = TNumericLimits<double>::Max(), EGridNavigatorPathSmoothing Smoothing = EGridNavigatorPathSmoothing::RemoveCollinear);
+
+	/**
+	 * Turns a path through grid nodes into world-space path points, adding the floor height stored on each edge
+	 * between nodes at different heights and dropping collinear points.
+	 *
+	 * @param Grid The grid the path was found in.
+	 * @param PathNodes The grid nodes that make up the path, in order.
+	 * @param Smoothing How the path's grid nodes are reduced to path points.
+	 * @return The finished path points, or an empty array if PathNodes is empty.
+	 */
+	static TArray<FVector> ProcessPath(const FNavGridAdjacencyList& Grid, const TArray<FInt64Vector3>& PathNodes, EGridNavigatorPathSmoothing Smoothing = EGridNavigatorPathSmoothing::RemoveCollinear);
+
+	/**
+	 * Pulls a path taut: drops every node that the path can skip by heading straight for a later node, as long
+	 * as the straight line only crosses flat grid cells joined by Direct edges.
+	 *
+	 * @param Grid The grid the path was found in.
+	 * @param PathNodes The grid nodes that make up the path, in order.
+	 * @return The nodes of PathNodes that the shortened path still turns at, including its start and end.
+	 */
+	static TArray<FInt64Vector3> StringPull(const FNavGridAdjacencyList& Grid, const TArray<FInt64Vector3>& PathNodes);
+
+	/**
+	 * Checks whether a straight line between two nodes stays on the grid, by walking every cell the line passes
+	 * through and requiring a same-height Direct edge between each cell and the next. Where the line passes
+	 * exactly through a cell corner, the diagonal edge across it is required instead.
+	 *
+	 * @param Grid The grid to check.
+	 * @param From The node the line starts at.
+	 * @param To The node the line ends at.
+	 * @return \c true if both nodes are at the same height and the line is unobstructed; \c false otherwise.
+	 */
+	static bool HasLineOfSight(const FNavGridAdjacencyList& Grid, const FInt64Vector3& From, const FInt64Vector3& To);
+
+	/**
+	 * Sums the edge costs along a path through grid nodes, as the frozen graph stores them, so the result matches
+	 * the cost plain A* gives the same path.
+	 *
+	 * @param Graph The frozen graph of the grid the path was found in.
+	 * @param PathNodes The grid nodes that make up the path, in order.
+	 * @return The cost of the path, in grid cells, or the largest double if any step of it is not an edge of Graph.
+	 */
+	static double GetPathCost(const FNavGridFrozenGraph& Graph, const TArray<FInt64Vector3>& PathNodes);
 };
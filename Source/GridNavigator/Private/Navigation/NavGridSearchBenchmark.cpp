@@ -0,0 +1,172 @@
+#include "AStarNavigator.h"
+#include "GridDistance.h"
+#include "GridNavigatorConfig.h"
+#include "HAL/IConsoleManager.h"
+#include "MapData/NavGridAdjacencyList.h"
+#include "MapData/NavGridComponents.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogNavGridSearchBenchmark, Log, All)
+
+using NavGrid::FAdjacencyListIndex;
+
+namespace
+{
+	// cells are grouped into square plateaus of this many cells a side, each at a random height
+	constexpr int32 PlateauSize = 8;
+
+	// plateau heights range from 0 to this, so neighboring plateaus are often joined by slopes
+	constexpr int32 MaxPlateauHeight = 2;
+
+	typedef TPair<FAdjacencyListIndex, FAdjacencyListIndex> FQuery;
+
+	/**
+	 * @brief Builds a synthetic Width x Width grid of plateaus with scattered obstacles. Each node is joined to
+	 * all eight of its neighbors, unless the neighbor is an obstacle or more than one height step away.
+	 */
+	void BuildGrid(const int32 Width, const int32 ObstaclePercent, FRandomStream& Random, FNavGridAdjacencyList& OutMap)
+	{
+		const int32 NumPlateaus = (Width + PlateauSize - 1) / PlateauSize;
+		TArray<int32> PlateauHeights;
+		PlateauHeights.SetNum(NumPlateaus * NumPlateaus);
+		for (int32& Height : PlateauHeights) {
+			Height = Random.RandRange(0, MaxPlateauHeight);
+		}
+
+		TArray<bool> IsObstacle;
+		IsObstacle.Reserve(Width * Width);
+		for (int32 Cell = 0; Cell < Width * Width; ++Cell) {
+			IsObstacle.Add(Random.RandRange(0, 99) < ObstaclePercent);
+		}
+
+		const auto GetNode = [&](const int64 X, const int64 Y) -> TOptional<FAdjacencyListIndex>
+		{
+			if (X < 0 || Y < 0 || X >= Width || Y >= Width || IsObstacle[X * Width + Y]) {
+				return {};
+			}
+			return FAdjacencyListIndex(X, Y, PlateauHeights[(X / PlateauSize) * NumPlateaus + Y / PlateauSize]);
+		};
+
+		for (int32 X = 0; X < Width; ++X) {
+			for (int32 Y = 0; Y < Width; ++Y) {
+				const TOptional<FAdjacencyListIndex> Index = GetNode(X, Y);
+				if (!Index.IsSet()) {
+					continue;
+				}
+				if (!OutMap.HasNode(*Index)) {
+					OutMap.AddNode(*Index);
+				}
+
+				for (int32 Direction = 0; Direction < NavGrid::NumDirections; ++Direction) {
+					const TOptional<FAdjacencyListIndex> Neighbor = GetNode(X + NavGrid::DirectionOffsetX[Direction], Y + NavGrid::DirectionOffsetY[Direction]);
+					if (!Neighbor.IsSet() || FMath::Abs(Neighbor->Z - Index->Z) > 1) {
+						continue;
+					}
+
+					const NavGrid::EMapEdgeType Type = Neighbor->Z == Index->Z ? NavGrid::Direct : NavGrid::Slope;
+					const float MidpointHeight = (Index->Z + Neighbor->Z) * GridNavigatorConfig::GridSizeZ / 2.0f;
+					OutMap.CreateEdge(*Index, *Neighbor, Type, MidpointHeight);
+				}
+			}
+		}
+		OutMap.Compact();
+	}
+
+	/**
+	 * @brief Picks random pairs of nodes that lie in the same connected component, so that every query has a
+	 * path to find and none of them floods the grid looking for one.
+	 */
+	TArray<FQuery> MakeQueries(const FNavGridAdjacencyList& Map, const int32 NumQueries, FRandomStream& Random)
+	{
+		TArray<FAdjacencyListIndex> Nodes;
+		Nodes.Reserve(Map.GetNumNodes());
+		Map.ForEachNode([&Nodes](const NavGrid::FNodeView& Node)
+		{
+			Nodes.Add(Node.Index);
+		});
+
+		TArray<FQuery> Queries;
+		if (Nodes.IsEmpty()) {
+			return Queries;
+		}
+
+		FNavGridComponents Components;
+		Components.Build(Map);
+
+		// give up eventually on grids that obstacles have split into single cells
+		const int32 MaxAttempts = NumQueries * 16;
+		for (int32 Attempt = 0; Attempt < MaxAttempts && Queries.Num() < NumQueries; ++Attempt) {
+			const FAdjacencyListIndex& Start = Nodes[Random.RandRange(0, Nodes.Num() - 1)];
+			const FAdjacencyListIndex& Goal = Nodes[Random.RandRange(0, Nodes.Num() - 1)];
+			if (Start != Goal && Components.AreConnected(Start, Goal)) {
+				Queries.Emplace(Start, Goal);
+			}
+		}
+		return Queries;
+	}
+
+	double GetPathCost(const TArray<FAdjacencyListIndex>& Path)
+	{
+		double Cost = 0.0;
+		for (int32 NodeIndex = 1; NodeIndex < Path.Num(); ++NodeIndex) {
+			Cost += Distance(Path[NodeIndex - 1], Path[NodeIndex]);
+		}
+		return Cost;
+	}
+
+	/**
+	 * @brief Runs every query with one combination of search policies, and logs the nodes it expanded, the time
+	 * it took and the total cost of the paths it found.
+	 */
+	template <typename HeuristicT, typename OpenSetT = TIndexedPriorityQueue<int32>>
+	void RunQueries(const TCHAR* Name, const FNavGridAdjacencyList& Map, const TArray<FQuery>& Queries)
+	{
+		TAStarNavigator<FNavGridAdjacencyList, FAdjacencyListIndex, HeuristicT, GridNavigatorSearch::FStoredEdgeCost, OpenSetT> Navigator;
+
+		int64 NumExpansions = 0;
+		int32 NumFound = 0;
+		double TotalCost = 0.0;
+		const double StartTime = FPlatformTime::Seconds();
+		for (const auto& [Start, Goal] : Queries) {
+			const TArray<FAdjacencyListIndex> Path = Navigator.Navigate(Map, Start, Goal);
+			NumExpansions += Navigator.NumExpansions;
+			NumFound += Path.IsEmpty() ? 0 : 1;
+			TotalCost += GetPathCost(Path);
+		}
+		const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		UE_LOG(LogNavGridSearchBenchmark, Display, TEXT("  %-28s %10lld expansions, %8.2f ms, %d paths costing %.1f cells"),
+			Name, NumExpansions, ElapsedMs, NumFound, TotalCost);
+	}
+
+	void RunSearchBenchmark(const TArray<FString>& Args)
+	{
+		const int32 Width = Args.Num() > 0 ? FMath::Max(2, FCString::Atoi(*Args[0])) : 256;
+		const int32 NumQueries = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 1000;
+		const int32 ObstaclePercent = Args.Num() > 2 ? FMath::Clamp(FCString::Atoi(*Args[2]), 0, 90) : 20;
+
+		FRandomStream Random(Width * 31 + ObstaclePercent);
+		FNavGridAdjacencyList Map;
+		BuildGrid(Width, ObstaclePercent, Random, Map);
+		const TArray<FQuery> Queries = MakeQueries(Map, NumQueries, Random);
+
+		UE_LOG(LogNavGridSearchBenchmark, Display, TEXT("%d x %d grid with %d%% obstacles, %d nodes, %d queries"), Width, Width, ObstaclePercent, Map.GetNumNodes(), Queries.Num());
+
+		UE_LOG(LogNavGridSearchBenchmark, Display, TEXT(" Heuristics:"));
+		RunQueries<GridNavigatorSearch::FEuclideanHeuristic2D>(TEXT("Euclidean 2D"), Map, Queries);
+		RunQueries<GridNavigatorSearch::FOctileHeuristic2D>(TEXT("Octile 2D"), Map, Queries);
+		RunQueries<GridNavigatorSearch::FOctileHeuristic3D>(TEXT("Octile 3D"), Map, Queries);
+		RunQueries<GridNavigatorSearch::FManhattanHeuristic>(TEXT("Manhattan (inadmissible)"), Map, Queries);
+
+		// the same search with each open set; the lazy queue pushes duplicates for improved nodes and skips them once stale
+		UE_LOG(LogNavGridSearchBenchmark, Display, TEXT(" Open sets (octile 2D):"));
+		RunQueries<GridNavigatorSearch::FOctileHeuristic2D, TIndexedPriorityQueue<int32>>(TEXT("Indexed, decrease-key"), Map, Queries);
+		RunQueries<GridNavigatorSearch::FOctileHeuristic2D, TPriorityQueue<int32>>(TEXT("Binary heap, lazy deletion"), Map, Queries);
+	}
+
+	FAutoConsoleCommand BenchmarkSearchCommand(
+		TEXT("GridNavigator.BenchmarkSearch"),
+		TEXT("Runs the same random queries over a synthetic grid with each A* heuristic policy and open set, and logs the nodes each expanded. ")
+		TEXT("Arguments: [Width=256] [Queries=1000] [ObstaclePercent=20]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunSearchBenchmark)
+	);
+}
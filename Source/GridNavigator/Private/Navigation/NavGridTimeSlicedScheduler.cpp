@@ -0,0 +1,187 @@
+#include "NavGridTimeSlicedScheduler.h"
+
+#include "GridNavigatorConfig.h"
+#include "NavigationGridData.h"
+#include "NavGridPathCache.h"
+#include "NavGridPathfinder.h"
+#include "NavGridQueryFilter.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogNavGridTimeSlicedScheduler, Log, All)
+
+FNavGridTimeSlicedScheduler::FNavGridTimeSlicedScheduler(const ANavigationGridData& NewNavData) : NavData(NewNavData)
+{
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FNavGridTimeSlicedScheduler::Tick));
+}
+
+FNavGridTimeSlicedScheduler::~FNavGridTimeSlicedScheduler()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	if (!PendingQueries.IsEmpty()) {
+		UE_LOG(LogNavGridTimeSlicedScheduler, Verbose, TEXT("Dropping %d unfinished time-sliced path queries"), PendingQueries.Num());
+	}
+}
+
+uint32 FNavGridTimeSlicedScheduler::Enqueue(const FPathFindingQuery& Query, const FNavPathQueryDelegate& ResultDelegate)
+{
+	check(IsInGameThread());
+
+	FNavGridTimeSlicedQuery& PendingQuery = PendingQueries.AddDefaulted_GetRef();
+	PendingQuery.QueryID = NextQueryID.fetch_add(1, std::memory_order_relaxed);
+	PendingQuery.Query = Query;
+	PendingQuery.OnDone = ResultDelegate;
+	PendingQuery.CostLimit = ANavigationGridData::GetGridCostLimit(Query);
+	return PendingQuery.QueryID;
+}
+
+bool FNavGridTimeSlicedScheduler::Abort(const uint32 QueryID)
+{
+	check(IsInGameThread());
+
+	return PendingQueries.RemoveAll([QueryID](const FNavGridTimeSlicedQuery& PendingQuery)
+	{
+		return PendingQuery.QueryID == QueryID;
+	}) > 0;
+}
+
+bool FNavGridTimeSlicedScheduler::Tick(float DeltaTime)
+{
+	if (PendingQueries.IsEmpty()) {
+		return true;
+	}
+
+	FNavGridPathCache& PathCache = *NavData.GetPathCache();
+	const double EndTime = FPlatformTime::Seconds() + FMath::Max(NavData.TimeSlicedBudgetMs, 0.0f) / 1000.0;
+
+	// results are reported once every query has been stepped, since result delegates are free to queue or abort queries
+	TArray<TPair<FNavGridTimeSlicedQuery, TArray<FVector>>> Finished;
+
+	int32 QueryIndex = 0;
+	int32 NumStepped = 0;
+	while (QueryIndex < PendingQueries.Num()) {
+		// the first query is always stepped, so queries keep making progress however small the budget is
+		const double Now = FPlatformTime::Seconds();
+		if (Now >= EndTime && NumStepped > 0) {
+			break;
+		}
+		++NumStepped;
+
+		FNavGridTimeSlicedQuery& PendingQuery = PendingQueries[QueryIndex];
+		TArray<FVector> Points;
+		bool bIsFinished = false;
+
+		if (!PendingQuery.Search) {
+			bIsFinished = StartSearch(PendingQuery, Points);
+		}
+
+		if (!bIsFinished) {
+			// share whatever is left of the budget evenly between this query and the ones that have yet to run
+			const int32 NumRemaining = PendingQueries.Num() - QueryIndex;
+			const FTimespan Slice = FTimespan::FromSeconds(FMath::Max(EndTime - Now, 0.0) / NumRemaining);
+
+			if (PendingQuery.Search->Step(Slice) != FNavGridTimeSlicedQuery::FSearch::EStatus::InProgress) {
+				const FNavGridLevel& Level = *PendingQuery.Level;
+				TArray<FInt64Vector3> PathNodes;
+				for (const uint32 Node : PendingQuery.Search->GetPath()) {
+					PathNodes.Add(Level.Graph.GetNodeIndex(Node));
+				}
+				const EGridNavigatorPathSmoothing Smoothing = FNavGridQueryFilter::GetPathSmoothing(PendingQuery.Query.QueryFilter.Get());
+				Points = FNavGridPathfinder::ProcessPath(Level.Map, PathNodes, Smoothing);
+				bIsFinished = true;
+
+				const FNavGridPathCacheKey CacheKey = {
+					GridNavigatorConfig::WorldToGridIndex(PendingQuery.Query.StartLocation),
+					GridNavigatorConfig::WorldToGridIndex(PendingQuery.Query.EndLocation),
+					Smoothing,
+					EGridNavigatorSearchMode::AStar,
+					PendingQuery.CostLimit,
+					Level.Version
+				};
+				PathCache.Add(CacheKey, Points);
+			}
+		}
+
+		if (bIsFinished) {
+			PendingQuery.Search.Reset();
+			PendingQuery.Level.Reset();
+			Finished.Emplace(MoveTemp(PendingQuery), MoveTemp(Points));
+			PendingQueries.RemoveAt(QueryIndex);
+		}
+		else {
+			++QueryIndex;
+		}
+	}
+
+	// move the queries that were stepped this frame behind the ones that were not reached, so those go first next frame
+	if (QueryIndex > 0 && QueryIndex < PendingQueries.Num()) {
+		TArray<FNavGridTimeSlicedQuery> Stepped;
+		Stepped.Reserve(QueryIndex);
+		for (int32 SteppedIndex = 0; SteppedIndex < QueryIndex; ++SteppedIndex) {
+			Stepped.Add(MoveTemp(PendingQueries[SteppedIndex]));
+		}
+		PendingQueries.RemoveAt(0, QueryIndex);
+		PendingQueries.Append(MoveTemp(Stepped));
+	}
+
+	for (const auto& [FinishedQuery, Points] : Finished) {
+		Complete(FinishedQuery, Points);
+	}
+
+	return true;
+}
+
+bool FNavGridTimeSlicedScheduler::StartSearch(FNavGridTimeSlicedQuery& PendingQuery, TArray<FVector>& OutPoints) const
+{
+	FNavGridPathCache& PathCache = *NavData.GetPathCache();
+
+	PendingQuery.Level = NavData.GetLevelData();
+	PendingQuery.Search.Reset();
+	const FNavGridLevel& Level = *PendingQuery.Level;
+	const FNavGridFrozenGraph& Graph = Level.Graph;
+
+	// snap both ends to their nearest nodes in the snapshot searched, the way FindPath does, so both find, cache
+	// and report the same path
+	PendingQuery.Query.StartLocation = NavData.SnapToNode(Level, PendingQuery.Query.StartLocation);
+	PendingQuery.Query.EndLocation = NavData.SnapToNode(Level, PendingQuery.Query.EndLocation);
+	const FInt64Vector3 FirstIndex = GridNavigatorConfig::WorldToGridIndex(PendingQuery.Query.StartLocation);
+	const FInt64Vector3 FinalIndex = GridNavigatorConfig::WorldToGridIndex(PendingQuery.Query.EndLocation);
+
+	const FNavGridPathCacheKey CacheKey = {
+		FirstIndex,
+		FinalIndex,
+		FNavGridQueryFilter::GetPathSmoothing(PendingQuery.Query.QueryFilter.Get()),
+		EGridNavigatorSearchMode::AStar,
+		PendingQuery.CostLimit,
+		Level.Version
+	};
+	if (PathCache.Find(CacheKey, OutPoints)) {
+		return true;
+	}
+
+	// also covers either end being off the grid, since only nodes in the grid have a component
+	if (!Level.Components.AreConnected(FirstIndex, FinalIndex)) {
+		OutPoints.Reset();
+		return true;
+	}
+
+	const uint32 FirstNode = Graph.FindNode(FirstIndex);
+	const uint32 FinalNode = Graph.FindNode(FinalIndex);
+	if (FirstNode == FNavGridFrozenGraph::InvalidNode || FinalNode == FNavGridFrozenGraph::InvalidNode) {
+		OutPoints.Reset();
+		return true;
+	}
+
+	PendingQuery.Search = MakeUnique<FNavGridTimeSlicedQuery::FSearch>(Graph, FirstNode, FinalNode);
+	PendingQuery.Search->SetCostLimit(PendingQuery.CostLimit);
+	PendingQuery.Search->SetHeuristic(FNavGridFrozenHeuristic(Graph, Level.Landmarks, FinalNode));
+	return false;
+}
+
+void FNavGridTimeSlicedScheduler::Complete(const FNavGridTimeSlicedQuery& PendingQuery, const TArray<FVector>& Points) const
+{
+	FPathFindingResult Result(ENavigationQueryResult::Error);
+	if (ANavigationGridData::PreparePathResult(NavData, PendingQuery.Query, Result)) {
+		ANavigationGridData::FinishPathResult(PendingQuery.Query, Points, Result);
+	}
+	PendingQuery.OnDone.ExecuteIfBound(PendingQuery.QueryID, Result.Result, Result.Path);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+
+#include "AStarNavigator.h"
+#include "Containers/Ticker.h"
+#include "MapData/NavGridAdjacencyList.h"
+#include "MapData/NavGridFrozenGraph.h"
+#include "MapData/NavGridLandmarks.h"
+#include "MapData/NavGridLevel.h"
+#include "NavigationData.h"
+
+class ANavigationGridData;
+
+/**
+ * @brief A pathfinding query whose search is spread over several frames.
+ */
+struct FNavGridTimeSlicedQuery
+{
+	typedef TAStarSearch<FNavGridFrozenGraph, uint32, FNavGridFrozenHeuristic> FSearch;
+
+	uint32 QueryID = 0;
+	FPathFindingQuery Query;
+	FNavPathQueryDelegate OnDone;
+
+	// the query's cost limit, converted to grid cells
+	double CostLimit = TNumericLimits<double>::Max();
+
+	// snapshot the search runs on, pinned until the query finishes so that rebuilds can be published meanwhile
+	TSharedPtr<const FNavGridLevel> Level;
+	TUniquePtr<FSearch> Search;
+};
+
+/**
+ * @class FNavGridTimeSlicedScheduler
+ * @brief Runs pathfinding queries on the game thread within a fixed time budget per frame.
+ *
+ * Each query owns a resumable A* search. Every frame, the budget is split evenly across the pending queries,
+ * and each one is stepped for its share before the next is picked up, so a single long query can never take
+ * much more than the frame's budget, and every query keeps making progress. The queue is rotated between frames,
+ * so queries that could not be reached within one frame's budget are served first in the next. The query at the
+ * front is stepped at least a little every frame, even with a budget of zero.
+ *
+ * Each search pins the snapshot of the level it was started on, and runs to completion against it, so
+ * rebuilds never pause or restart searches in progress.
+ */
+class FNavGridTimeSlicedScheduler
+{
+public:
+	explicit FNavGridTimeSlicedScheduler(const ANavigationGridData& NewNavData);
+	~FNavGridTimeSlicedScheduler();
+
+	/**
+	 * @brief Queues a query to be searched over the next few frames. Must be called on the game thread.
+	 *
+	 * @param Query The query to run; its start and end locations are snapped to their nearest nodes in the snapshot
+	 * its search starts on, as FindPath does, and its path instance is filled if set
+	 * @param ResultDelegate Called on the game thread once the query has finished
+	 * @return ID of the query, which is also passed to ResultDelegate
+	 */
+	uint32 Enqueue(const FPathFindingQuery& Query, const FNavPathQueryDelegate& ResultDelegate);
+
+	/**
+	 * @brief Drops a pending query without reporting a result.
+	 *
+	 * @return \c true if the query was pending; \c false if it had already finished or was never queued
+	 */
+	bool Abort(uint32 QueryID);
+
+	FORCEINLINE int32 GetNumPendingQueries() const { return PendingQueries.Num(); }
+
+private:
+	bool Tick(float DeltaTime);
+
+	/**
+	 * @brief Starts the search for a query against the current snapshot of the level, snapping the query's start
+	 * and end locations to that snapshot's nodes.
+	 *
+	 * @return \c true if the query could be resolved right away and is ready to be completed
+	 */
+	bool StartSearch(FNavGridTimeSlicedQuery& PendingQuery, TArray<FVector>& OutPoints) const;
+
+	void Complete(const FNavGridTimeSlicedQuery& PendingQuery, const TArray<FVector>& Points) const;
+
+	const ANavigationGridData& NavData;
+	TArray<FNavGridTimeSlicedQuery> PendingQueries;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	static inline std::atomic<uint32> NextQueryID = 1;
+};
@@ -7,10 +7,10 @@ template <typename NodeT>
 struct TPriorityQueueNode
 {
 	NodeT Element;
-	float Priority;
+	double Priority;
 
 	TPriorityQueueNode() = default;
-	TPriorityQueueNode(NodeT InElement, float InPriority) : Element(InElement), Priority(InPriority) {}
+	TPriorityQueueNode(NodeT InElement, double InPriority) : Element(InElement), Priority(InPriority) {}
 
 	bool operator<(const TPriorityQueueNode<NodeT>& Other) const
 	{
@@ -31,7 +31,13 @@ public:
 		return Node.Element;
 	}
 	
-	void Push(InType Element, float Priority)
+	/**
+	 * @brief Adds an element to the queue.
+	 *
+	 * @note There is no decrease-key; pushing an element that is already queued adds a second entry, and
+	 * callers are expected to skip the stale entry when it is eventually popped.
+	 */
+	void Push(InType Element, double Priority)
 	{
 		this->Data.HeapPush(TPriorityQueueNode<InType>(Element, Priority));
 	}
@@ -41,6 +47,33 @@ public:
 		return this->Data.IsEmpty();
 	}
 
+	int32 Num() const
+	{
+		return this->Data.Num();
+	}
+
+	/**
+	 * @return The lowest priority in the queue, which may belong to a stale entry
+	 * @pre The queue must not be empty.
+	 */
+	double GetMinPriority() const
+	{
+		return this->Data.HeapTop().Priority;
+	}
+
+	/**
+	 * @brief Removes all queued elements without releasing the queue's allocation.
+	 */
+	void Reset()
+	{
+		this->Data.Reset();
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return this->Data.GetAllocatedSize();
+	}
+
 private:
 	TArray<TPriorityQueueNode<InType>> Data;
 };
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "GridNavigatorConfig.h"
+
+/*
+ * Heuristic and edge-cost policies for the search templates.
+ *
+ * Policies are plain types with static member functions, passed as template parameters so that every call
+ * inlines into the search loop. Costs and estimates are measured in horizontal grid cells.
+ *
+ * Heuristic policies provide:
+ *   static double Estimate(const LocationT& From, const LocationT& To);
+ * or, for heuristics backed by precomputed data (eg. FNavGridLandmarkHeuristic), the same signature as a const
+ * member function. Only TAStarSearch keeps an instance of its heuristic; the other searches need static policies.
+ *
+ * Edge-cost policies provide:
+ *   static double GetCost(const LocationT& From, const LocationT& To, double StoredCost);
+ * where StoredCost is the cost the map reports for the edge between From and To.
+ */
+
+namespace GridNavigatorSearch
+{
+	// ratio between a vertical and a horizontal grid step, in world units
+	inline constexpr double ZScale = GridNavigatorConfig::GridSizeZ / GridNavigatorConfig::GridSizeX;
+
+	/**
+	 * @return The length of the shortest eight-connected path across a flat, empty grid
+	 */
+	FORCEINLINE double OctileDistance(const double DX, const double DY)
+	{
+		const double AbsX = FMath::Abs(DX);
+		const double AbsY = FMath::Abs(DY);
+		return FMath::Max(AbsX, AbsY) + (UE_DOUBLE_SQRT_2 - 1.0) * FMath::Min(AbsX, AbsY);
+	}
+
+	/**
+	 * @brief Straight-line distance, ignoring height. This was the original pathfinding heuristic.
+	 */
+	struct FEuclideanHeuristic2D
+	{
+		template <typename LocationT>
+		static FORCEINLINE double Estimate(const LocationT& From, const LocationT& To)
+		{
+			const double DX = static_cast<double>(To.X - From.X);
+			const double DY = static_cast<double>(To.Y - From.Y);
+			return FMath::Sqrt(DX * DX + DY * DY);
+		}
+	};
+
+	/**
+	 * @brief Octile distance, ignoring height. Never overestimates on an eight-connected grid, and is tighter
+	 * than FEuclideanHeuristic2D because it accounts for movement being limited to eight directions.
+	 */
+	struct FOctileHeuristic2D
+	{
+		template <typename LocationT>
+		static FORCEINLINE double Estimate(const LocationT& From, const LocationT& To)
+		{
+			return OctileDistance(static_cast<double>(To.X - From.X), static_cast<double>(To.Y - From.Y));
+		}
+	};
+
+	/**
+	 * @brief Octile distance combined with the height difference, scaled by the ratio between the vertical
+	 * and horizontal grid sizes. Admissible for both FStoredEdgeCost and FWorldScaledEdgeCost.
+	 */
+	struct FOctileHeuristic3D
+	{
+		template <typename LocationT>
+		static FORCEINLINE double Estimate(const LocationT& From, const LocationT& To)
+		{
+			const double Planar = OctileDistance(static_cast<double>(To.X - From.X), static_cast<double>(To.Y - From.Y));
+			const double Vertical = static_cast<double>(To.Z - From.Z) * ZScale;
+			return FMath::Sqrt(Planar * Planar + Vertical * Vertical);
+		}
+	};
+
+	/**
+	 * @brief Manhattan distance, ignoring height.
+	 *
+	 * @note Overestimates diagonal movement, so searches using it expand fewer nodes but are not guaranteed
+	 * to return the shortest path.
+	 */
+	struct FManhattanHeuristic
+	{
+		template <typename LocationT>
+		static FORCEINLINE double Estimate(const LocationT& From, const LocationT& To)
+		{
+			return FMath::Abs(static_cast<double>(To.X - From.X)) + FMath::Abs(static_cast<double>(To.Y - From.Y));
+		}
+	};
+
+	/**
+	 * @brief Uses the cost stored on the map's edges as-is (3D Euclidean length in grid cells for
+	 * FNavGridAdjacencyList, where a vertical cell counts as much as a horizontal one).
+	 */
+	struct FStoredEdgeCost
+	{
+		template <typename LocationT>
+		static FORCEINLINE double GetCost(const LocationT& From, const LocationT& To, const double StoredCost)
+		{
+			return StoredCost;
+		}
+	};
+
+	/**
+	 * @brief Euclidean length of the edge in world units (divided by the horizontal grid size), so height
+	 * changes cost in proportion to their actual size.
+	 */
+	struct FWorldScaledEdgeCost
+	{
+		template <typename LocationT>
+		static FORCEINLINE double GetCost(const LocationT& From, const LocationT& To, const double StoredCost)
+		{
+			const double DX = static_cast<double>(To.X - From.X);
+			const double DY = static_cast<double>(To.Y - From.Y);
+			const double DZ = static_cast<double>(To.Z - From.Z) * ZScale;
+			return FMath::Sqrt(DX * DX + DY * DY + DZ * DZ);
+		}
+	};
+}
+
+template <typename PolicyT, typename LocationT>
+concept is_heuristic_policy = requires(const PolicyT& Policy, const LocationT& From, const LocationT& To) {
+	{ Policy.Estimate(From, To) } -> std::convertible_to<double>;
+};
+
+template <typename PolicyT, typename LocationT>
+concept is_edge_cost_policy = requires(const LocationT& From, const LocationT& To, double StoredCost) {
+	{ PolicyT::GetCost(From, To, StoredCost) } -> std::convertible_to<double>;
+};
@@ -5,20 +5,44 @@
 
 #include <functional>
 
+#include "Async/ParallelFor.h"
+
 #include "GridNavigatorConfig.h"
 #include "Display/NavGridRenderingComponent.h"
 #include "NavMesh/PImplRecastNavMesh.h"
 #include "NavigationGridDataGenerator.h"
+#include "NavGridQueryFilter.h"
 #include "MapData/NavGridDataSerializer.h"
 #include "MapData/NavGridLevel.h"
+#include "Navigation/NavGridAsyncQueryQueue.h"
+#include "Navigation/NavGridChangeJournal.h"
+#include "Navigation/NavGridCostMatrix.h"
+#include "Navigation/NavGridFlowField.h"
+#include "Navigation/NavGridMovementRange.h"
+#include "Navigation/NavGridPathCache.h"
 #include "Navigation/NavGridPathfinder.h"
+#include "Navigation/NavGridTimeSlicedScheduler.h"
 
 DECLARE_LOG_CATEGORY_CLASS(LogNavigationGridData, Log, All);
 
+namespace
+{
+	// projection workloads smaller than this are not worth handing out to worker threads
+	constexpr int32 MinParallelProjections = 64;
+}
+
 ANavigationGridData::ANavigationGridData(const FObjectInitializer& ObjectInitializer) : ARecastNavMesh(ObjectInitializer)
 {
 	FindPathImplementation = this->FindPath;
 	LevelData = MakeShared<FNavGridLevel>();
+	PathCache = MakeShared<FNavGridPathCache>(PathCacheCapacity);
+	ChangeJournal = MakeShared<FNavGridChangeJournal>();
+	FlowFields = MakeShared<FNavGridFlowFieldCache>(FlowFieldCacheCapacity);
+
+	if (!HasAnyFlags(RF_ClassDefaultObject)) {
+		AsyncQueries = MakeShared<FNavGridAsyncQueryQueue>();
+		TimeSlicedQueries = MakeShared<FNavGridTimeSlicedScheduler>(*this);
+	}
 }
 
 void ANavigationGridData::OnNavigationBoundsChanged()
@@ -38,20 +62,232 @@ UPrimitiveComponent* ANavigationGridData::ConstructRenderingComponent()
 
 FBox ANavigationGridData::GetBounds() const
 {
-	if (!LevelData) {
+	const TSharedPtr<const FNavGridLevel> Level = GetLevelData();
+	if (!Level) {
 		UE_LOG(LogNavigationGridData, Error, TEXT("Tried to GetBounds without any instantiated level data"));
 		return FBox();
 	}
 	
-	return LevelData->GetBounds();
+	return Level->GetBounds();
+}
+
+bool ANavigationGridData::ProjectPoint(const FVector& Point, FNavLocation& OutLocation, const FVector& Extent, FSharedConstNavQueryFilter Filter, const UObject* Querier) const
+{
+	const TSharedPtr<const FNavGridLevel> Level = GetLevelData();
+	if (!Level) {
+		UE_LOG(LogNavigationGridData, Error, TEXT("Tried to ProjectPoint without any instantiated level data"));
+		return false;
+	}
+
+	const FNavGridFrozenGraph& Graph = Level->Graph;
+	const uint32 Node = Graph.FindNearestNode(Point, Extent.IsZero() ? GetDefaultQueryExtent() : Extent);
+	if (Node == FNavGridFrozenGraph::InvalidNode) {
+		return false;
+	}
+
+	OutLocation = FNavLocation(Graph.GetNodeWorldLocation(Node));
+	return true;
+}
+
+void ANavigationGridData::BatchProjectPoints(TArray<FNavigationProjectionWork>& Workload, const FVector& Extent, FSharedConstNavQueryFilter Filter, const UObject* Querier) const
+{
+	const FVector SearchExtent = Extent.IsZero() ? GetDefaultQueryExtent() : Extent;
+	ProjectWorkload(Workload, [&SearchExtent](const FNavigationProjectionWork& Work)
+	{
+		return FBox(Work.Point - SearchExtent, Work.Point + SearchExtent);
+	});
 }
 
+void ANavigationGridData::BatchProjectPoints(TArray<FNavigationProjectionWork>& Workload, FSharedConstNavQueryFilter Filter, const UObject* Querier) const
+{
+	ProjectWorkload(Workload, [](const FNavigationProjectionWork& Work)
+	{
+		return Work.ProjectionLimit;
+	});
+}
+
+void ANavigationGridData::PostInitProperties()
+{
+	Super::PostInitProperties();
+	if (!HasAnyFlags(RF_ClassDefaultObject)) {
+		UseGridQueryFilter();
+		ApplyCacheCapacities();
+	}
+}
+
+void ANavigationGridData::PostLoad()
+{
+	Super::PostLoad();
+	UseGridQueryFilter();
+	ApplyCacheCapacities();
+}
+
+#if WITH_EDITOR
+void ANavigationGridData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	UseGridQueryFilter();
+	ApplyCacheCapacities();
+}
+#endif
+
 void ANavigationGridData::Serialize(FArchive& Ar)
 {
 	Super::Serialize(Ar);
 	FNavGridDataSerializer::Serialize(Ar, this);
 }
 
+void ANavigationGridData::BeginDestroy()
+{
+	// queries in flight still reference this object, so let them finish first; the ones that have not started
+	// never will, so their callers are told they failed rather than left waiting
+	if (AsyncQueries) {
+		AsyncQueries->Flush();
+		AsyncQueries->CancelPending();
+		AsyncQueries.Reset();
+	}
+	TimeSlicedQueries.Reset();
+	Super::BeginDestroy();
+}
+
+uint32 ANavigationGridData::FindPathAsync(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query, const FNavPathQueryDelegate& ResultDelegate) const
+{
+	if (!AsyncQueries) {
+		UE_LOG(LogNavigationGridData, Error, TEXT("Tried to FindPathAsync on navigation data without an async query queue"));
+		return INVALID_NAVQUERYID;
+	}
+	return AsyncQueries->Enqueue(AgentProperties, Query, ResultDelegate);
+}
+
+uint32 ANavigationGridData::FindPathTimeSliced(const FPathFindingQuery& Query, const FNavPathQueryDelegate& ResultDelegate) const
+{
+	if (!TimeSlicedQueries) {
+		UE_LOG(LogNavigationGridData, Error, TEXT("Tried to FindPathTimeSliced on navigation data without a time-sliced query scheduler"));
+		return INVALID_NAVQUERYID;
+	}
+	return TimeSlicedQueries->Enqueue(Query, ResultDelegate);
+}
+
+bool ANavigationGridData::AbortTimeSlicedQuery(const uint32 QueryID) const
+{
+	return TimeSlicedQueries && TimeSlicedQueries->Abort(QueryID);
+}
+
+bool ANavigationGridData::FindMovementRange(const FVector& Origin, const double CostLimit, FNavGridMovementRange& OutRange) const
+{
+	OutRange.Reset();
+	const TSharedPtr<const FNavGridLevel> Level = GetLevelData();
+	if (!Level) {
+		UE_LOG(LogNavigationGridData, Error, TEXT("Tried to FindMovementRange without any instantiated level data"));
+		return false;
+	}
+
+	const FInt64Vector3 OriginIndex = GridNavigatorConfig::WorldToGridIndex(SnapToNode(*Level, Origin));
+	OutRange.Build(Level->Graph, OriginIndex, CostLimit / GridNavigatorConfig::ASSUMED_GRID_SPACING);
+	return !OutRange.IsEmpty();
+}
+
+bool ANavigationGridData::GetReachableLocations(const FVector& Origin, const float CostLimit, TArray<FVector>& OutLocations, TArray<float>& OutCosts) const
+{
+	OutLocations.Reset();
+	OutCosts.Reset();
+
+	FNavGridMovementRange Range;
+	if (!FindMovementRange(Origin, CostLimit, Range)) {
+		return false;
+	}
+
+	OutLocations.Reserve(Range.Num());
+	OutCosts.Reserve(Range.Num());
+	for (const auto& [Location, ParentIndex, Cost] : Range.GetEntries()) {
+		OutLocations.Add(GridNavigatorConfig::GridIndexToWorld(Location));
+		OutCosts.Add(static_cast<float>(Cost * GridNavigatorConfig::ASSUMED_GRID_SPACING));
+	}
+	return true;
+}
+
+bool ANavigationGridData::FindCostMatrix(const TConstArrayView<FVector> Sources, const TConstArrayView<FVector> Targets, FNavGridCostMatrix& OutMatrix, const double CostLimit) const
+{
+	OutMatrix.Reset();
+	const TSharedPtr<const FNavGridLevel> Level = GetLevelData();
+	if (!Level) {
+		UE_LOG(LogNavigationGridData, Error, TEXT("Tried to FindCostMatrix without any instantiated level data"));
+		return false;
+	}
+
+	TArray<FInt64Vector3> SourceIndices;
+	SourceIndices.Reserve(Sources.Num());
+	for (const FVector& Source : Sources) {
+		SourceIndices.Add(GridNavigatorConfig::WorldToGridIndex(SnapToNode(*Level, Source)));
+	}
+
+	TArray<FInt64Vector3> TargetIndices;
+	TargetIndices.Reserve(Targets.Num());
+	for (const FVector& Target : Targets) {
+		TargetIndices.Add(GridNavigatorConfig::WorldToGridIndex(SnapToNode(*Level, Target)));
+	}
+
+	OutMatrix.Build(Level->Graph, SourceIndices, TargetIndices, CostLimit / GridNavigatorConfig::ASSUMED_GRID_SPACING);
+	return true;
+}
+
+bool ANavigationGridData::GetPathCostMatrix(const TArray<FVector>& Sources, const TArray<FVector>& Targets, TArray<float>& OutCosts) const
+{
+	OutCosts.Reset();
+
+	FNavGridCostMatrix Matrix;
+	if (!FindCostMatrix(Sources, Targets, Matrix)) {
+		return false;
+	}
+
+	OutCosts.Reserve(Matrix.GetCosts().Num());
+	for (const double Cost : Matrix.GetCosts()) {
+		OutCosts.Add(Cost >= 0.0 ? static_cast<float>(Cost * GridNavigatorConfig::ASSUMED_GRID_SPACING) : -1.0f);
+	}
+	return true;
+}
+
+bool ANavigationGridData::AreConnected(const FVector& A, const FVector& B) const
+{
+	const TSharedPtr<const FNavGridLevel> Level = GetLevelData();
+	if (!Level) {
+		UE_LOG(LogNavigationGridData, Error, TEXT("Tried to check AreConnected without any instantiated level data"));
+		return false;
+	}
+	return Level->Components.AreConnected(GridNavigatorConfig::WorldToGridIndex(SnapToNode(*Level, A)), GridNavigatorConfig::WorldToGridIndex(SnapToNode(*Level, B)));
+}
+
+TSharedRef<const FNavGridFlowField> ANavigationGridData::GetFlowField(const FVector& Goal) const
+{
+	return GetFlowField(*GetLevelData(), Goal);
+}
+
+TSharedRef<const FNavGridFlowField> ANavigationGridData::GetFlowField(const FNavGridLevel& Level, const FVector& Goal) const
+{
+	return FlowFields->FindOrBuild(Level.Graph, GridNavigatorConfig::WorldToGridIndex(SnapToNode(Level, Goal)), Level.Version);
+}
+
+FPathFindingResult ANavigationGridData::FindPathFromFlowField(const FNavGridFlowField& FlowField, const FPathFindingQuery& Query) const
+{
+	FPathFindingResult Result(ENavigationQueryResult::Error);
+
+	const TSharedPtr<const FNavGridLevel> Level = GetLevelData();
+	if (!Level) {
+		UE_LOG(LogNavigationGridData, Error, TEXT("Tried to FindPathFromFlowField without any instantiated level data"));
+		return Result;
+	}
+	if (!PreparePathResult(*this, Query, Result)) {
+		return Result;
+	}
+
+	FPathFindingQuery SnappedQuery(Query);
+	SnappedQuery.StartLocation = SnapToNode(*Level, Query.StartLocation);
+
+	const TArray<FVector> Points = FNavGridPathfinder::FollowFlowField(Level->Map, FlowField, SnappedQuery.StartLocation, GetGridCostLimit(Query), FNavGridQueryFilter::GetPathSmoothing(Query.QueryFilter.Get()));
+	FinishPathResult(SnappedQuery, Points, Result);
+	return Result;
+}
+
 void ANavigationGridData::ConditionalConstructGenerator()
 {
 	if (NavDataGenerator.IsValid()) {
@@ -80,36 +316,52 @@ void ANavigationGridData::RebuildNavigation() const
 
 FString ANavigationGridData::GetDataString() const
 {
-	return LevelData->ToString();
+	return GetLevelData()->ToString();
 }
 
-// ReSharper disable once CppMemberFunctionMayBeConst
 void ANavigationGridData::UpdateBlockData(const uint32 BlockID, const FBox& NewBoundData)
 {
-	LevelData->UpdateBlock(BlockID, FNavGridBlock(NewBoundData, BlockID));
+	Blocks[BlockID] = FNavGridBlock(NewBoundData, BlockID);
 }
 
-TMap<uint32, FNavGridBlock>& ANavigationGridData::GetNavigationBlocks() const
+TMap<uint32, FNavGridBlock>& ANavigationGridData::GetNavigationBlocks()
 {
-	return LevelData->Blocks;
+	return Blocks;
 }
 
-TSharedPtr<FNavGridLevel> ANavigationGridData::GetLevelData() const
+TSharedPtr<const FNavGridLevel> ANavigationGridData::GetLevelData() const
 {
+	FScopeLock ScopeLock(&LevelDataLock);
 	return LevelData;
 }
 
-TArray<NavGrid::FNode> ANavigationGridData::GetNodeList() const
+uint32 ANavigationGridData::GetGraphVersion() const
 {
-	if (!LevelData) {
-		return {};
-	}
-	return LevelData->Map.GetNodeList();
+	FScopeLock ScopeLock(&LevelDataLock);
+	return GraphVersion;
+}
+
+FNavGridLevel ANavigationGridData::GetLevelDataBlueprint() const
+{
+	// copied while the snapshot is pinned, since it is released as soon as a newer one is published
+	return *GetLevelData();
 }
 
-FNavGridLevel& ANavigationGridData::GetLevelDataBlueprint() const
+void ANavigationGridData::PublishLevelData(const TSharedRef<FNavGridLevel>& NewLevel, TArray<FInt64Vector3>&& ChangedNodes)
 {
-	return *LevelData;
+	{
+		FScopeLock ScopeLock(&LevelDataLock);
+
+		// the changes are recorded first, so whoever sees the new snapshot can also find out what changed in it
+		NewLevel->Version = ++GraphVersion;
+		ChangeJournal->Record(NewLevel->Version, MoveTemp(ChangedNodes));
+		LevelData = NewLevel;
+
+		// results found on older snapshots must not be reused, and can never be hit again, so drop them all now
+		PathCache->SetGraphVersion(NewLevel->Version);
+	}
+
+	UE_LOG(LogNavigationGridData, Log, TEXT("Published version %u of the navigation grid for %s"), NewLevel->Version, *GetPathName());
 }
 
 FPathFindingResult ANavigationGridData::FindPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query)
@@ -120,11 +372,8 @@ FPathFindingResult ANavigationGridData::FindPath(const FNavAgentProperties& Agen
 
 	FPathFindingResult Result(ENavigationQueryResult::Error);
 
-	UE_LOG(LogNavigationGridData, Log, TEXT("Got cost limit of: '%0.2f'"), Query.CostLimit);
-
 	const auto* Self = Cast<const ANavigationGridData>(Query.NavData.Get());
 	const auto* NavFilter = Query.QueryFilter.Get();
-	const auto* World = Self->GetWorld();
 
 	if (!Self) {
 		UE_LOG(LogNavigationGridData, Error, TEXT("Failed to retrieve reference to RecastNavMesh in FindPath"));
@@ -134,11 +383,128 @@ FPathFindingResult ANavigationGridData::FindPath(const FNavAgentProperties& Agen
 		UE_LOG(LogNavigationGridData, Error, TEXT("Failed to retrieve reference to query filter in FindPath"));
 		return Result;
 	}
-	if (World == nullptr) {
-		UE_LOG(LogNavigationGridData, Error, TEXT("Failed to retrieve world reference in FindPath"));
+
+	// the whole query runs against the snapshot that is current now, even if a newer one is published meanwhile
+	const TSharedPtr<const FNavGridLevel> Level = Self->GetLevelData();
+	if (!Level) {
+		UE_LOG(LogNavigationGridData, Error, TEXT("Tried to FindPath without any instantiated level data"));
 		return Result;
 	}
 	
+	if (!PreparePathResult(*Self, Query, Result)) {
+		return Result;
+	}
+
+	// if travel distance is very small, return the corresponding very short path early
+	const FVector AdjustedEndLocation = NavFilter->GetAdjustedEndLocation(Query.EndLocation);
+	if ((Query.StartLocation - AdjustedEndLocation).IsNearlyZero()) {
+		Result.Path->GetPathPoints().Reset();
+		Result.Path->GetPathPoints().Add(FNavPathPoint(AdjustedEndLocation));
+		Result.Result = ENavigationQueryResult::Success;
+
+		return Result;
+	}
+
+	// locations that are a little above the floor or beside a node still find a path, from and to the nearest nodes
+	FPathFindingQuery SnappedQuery(Query);
+	SnappedQuery.StartLocation = Self->SnapToNode(*Level, Query.StartLocation);
+	SnappedQuery.EndLocation = Self->SnapToNode(*Level, Query.EndLocation);
+
+	const double CostLimit = GetGridCostLimit(Query);
+	const EGridNavigatorPathSmoothing Smoothing = FNavGridQueryFilter::GetPathSmoothing(NavFilter);
+
+	UE_LOG(LogNavigationGridData, Log, TEXT("FindPath with nav data: %s"), *Self->GetPathName());
+
+	// identical queries against an unchanged graph always produce the same points, so reuse them when possible
+	FNavGridPathCache& PathCache = *Self->PathCache;
+
+	const FNavGridPathCacheKey CacheKey = {
+		GridNavigatorConfig::WorldToGridIndex(SnappedQuery.StartLocation),
+		GridNavigatorConfig::WorldToGridIndex(SnappedQuery.EndLocation),
+		Smoothing,
+		Self->SearchMode,
+		CostLimit,
+		Level->Version
+	};
+
+	TArray<FVector> Points;
+	if (!PathCache.Find(CacheKey, Points)) {
+		// no search could find a path within the limit, so do not pay for one (least of all a whole flow field)
+		if (!FNavGridPathfinder::IsBeyondCostLimit(*Level, SnappedQuery.StartLocation, SnappedQuery.EndLocation, CostLimit)) {
+			if (Self->SearchMode == EGridNavigatorSearchMode::FlowField) {
+				Points = FNavGridPathfinder::FollowFlowField(Level->Map, *Self->GetFlowField(*Level, SnappedQuery.EndLocation), SnappedQuery.StartLocation, CostLimit, Smoothing);
+			}
+			else {
+				Points = FNavGridPathfinder::FindPath(*Level, SnappedQuery.StartLocation, SnappedQuery.EndLocation, Self->SearchMode, CostLimit, Smoothing);
+			}
+		}
+
+		PathCache.Add(CacheKey, Points);
+	}
+
+	FinishPathResult(SnappedQuery, Points, Result);
+	return Result;
+}
+
+void ANavigationGridData::ProjectWorkload(TArray<FNavigationProjectionWork>& Workload, const TFunctionRef<FBox(const FNavigationProjectionWork&)> GetSearchBounds) const
+{
+	const TSharedPtr<const FNavGridLevel> Level = GetLevelData();
+	if (!Level) {
+		UE_LOG(LogNavigationGridData, Error, TEXT("Tried to BatchProjectPoints without any instantiated level data"));
+		return;
+	}
+
+	// every item writes only to itself, and the graph is only read, so items never touch the same data
+	const FNavGridFrozenGraph& Graph = Level->Graph;
+	ParallelFor(Workload.Num(), [&](const int32 WorkIndex)
+	{
+		FNavigationProjectionWork& Work = Workload[WorkIndex];
+		if (!Work.bIsValid) {
+			return;
+		}
+
+		const uint32 Node = Graph.FindNearestNode(Work.Point, GetSearchBounds(Work));
+		Work.bResult = Node != FNavGridFrozenGraph::InvalidNode;
+		if (Work.bResult) {
+			Work.OutLocation = FNavLocation(Graph.GetNodeWorldLocation(Node));
+		}
+	}, Workload.Num() < MinParallelProjections ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+FVector ANavigationGridData::SnapToNode(const FNavGridLevel& Level, const FVector& Location) const
+{
+	const FNavGridFrozenGraph& Graph = Level.Graph;
+	const uint32 Node = Graph.FindNearestNode(Location, GetDefaultQueryExtent());
+	return Node != FNavGridFrozenGraph::InvalidNode ? Graph.GetNodeWorldLocation(Node) : Location;
+}
+
+void ANavigationGridData::UseGridQueryFilter()
+{
+	// every filter made for this data starts as a copy of the default one, so they all carry the grid's options
+	const INavigationQueryFilterInterface* Implementation = DefaultQueryFilter.IsValid() ? DefaultQueryFilter->GetImplementation() : nullptr;
+	if (Implementation == nullptr || FNavGridQueryFilter::Cast(Implementation)) {
+		return;
+	}
+
+	// anything else is the Recast implementation ARecastNavMesh sets up, which the grid filter extends
+	const FNavGridQueryFilter GridFilter(*static_cast<const FRecastQueryFilter*>(Implementation));
+	DefaultQueryFilter->SetFilterImplementation(&GridFilter);
+}
+
+void ANavigationGridData::ApplyCacheCapacities()
+{
+	PathCache->SetCapacity(PathCacheCapacity);
+	FlowFields->SetCapacity(FlowFieldCacheCapacity);
+}
+
+double ANavigationGridData::GetGridCostLimit(const FPathFindingQuery& Query)
+{
+	// edge costs are measured in grid cells, while query costs are measured in world units
+	return Query.CostLimit / GridNavigatorConfig::ASSUMED_GRID_SPACING;
+}
+
+bool ANavigationGridData::PreparePathResult(const ANavigationGridData& Self, const FPathFindingQuery& Query, FPathFindingResult& Result)
+{
 	auto* NavPath = Query.PathInstanceToFill.Get();
 	auto* NavMeshPath = NavPath ? NavPath->CastPath<FNavMeshPath>() : nullptr;
 
@@ -147,52 +513,37 @@ FPathFindingResult ANavigationGridData::FindPath(const FNavAgentProperties& Agen
 		NavMeshPath->ResetForRepath();
 	}
 	else {
-		Result.Path = Self->CreatePathInstance<FNavMeshPath>(Query);
+		Result.Path = Self.CreatePathInstance<FNavMeshPath>(Query);
 		NavPath = Result.Path.Get();
 		NavMeshPath = NavPath ? NavPath->CastPath<FNavMeshPath>() : nullptr;
 	}
 
 	if (!NavMeshPath) {
 		UE_LOG(LogNavigationGridData, Error, TEXT("Somehow failed to instantiate destination navpath in FindPath; this should never happen"));
-		return Result;
+		return false;
 	}
 
 	NavMeshPath->ApplyFlags(Query.NavDataFlags);
+	return true;
+}
 
-	// if travel distance is very small, return the corresponding very short path early
-	const FVector AdjustedEndLocation = NavFilter->GetAdjustedEndLocation(Query.EndLocation);
-	if ((Query.StartLocation - AdjustedEndLocation).IsNearlyZero()) {
-		Result.Path->GetPathPoints().Reset();
-		Result.Path->GetPathPoints().Add(FNavPathPoint(AdjustedEndLocation));
-		Result.Result = ENavigationQueryResult::Success;
-
-		return Result;
-	}
-
-	const float DistanceBudget = Query.CostLimit;
-	const FVector StartLocation = GridNavigatorConfig::RoundToGrid(Query.StartLocation);
-	const FVector EndLocation   = GridNavigatorConfig::RoundToGrid(Query.EndLocation);
-
-	UE_LOG(LogNavigationGridData, Log, TEXT("FindPath with nav data: %s"), *Self->GetPathName());
-
-	const auto Points = FNavGridPathfinder::FindPath(*World, Self->LevelData->Map, Query.StartLocation, Query.EndLocation);
-
+void ANavigationGridData::FinishPathResult(const FPathFindingQuery& Query, const TArray<FVector>& Points, FPathFindingResult& Result)
+{
 	if (Points.IsEmpty()) {
 		Result = ENavigationQueryResult::Fail;
-		return Result;
+		return;
 	}
 	
 	for (const auto& Point : Points) {
 		Result.Path->GetPathPoints().Add(Point);
 	}
 
+	const FVector EndLocation = GridNavigatorConfig::RoundToGrid(Query.EndLocation);
 	if (FVector::Distance(Points.Last(), EndLocation) > 0.1 && !Query.bAllowPartialPaths) {
 		Result.Result = ENavigationQueryResult::Fail;
-		return Result;
+		return;
 	}
 
 	Result.Path->MarkReady();
 	Result.Result = ENavigationQueryResult::Success;
-
-	return Result;
 }
@@ -76,23 +76,25 @@ void FNavigationGridDataGenerator::RebuildDirtyAreas(const TArray<FNavigationDir
 		}
 	}
 
+	// blocks are only edited here, on the game thread; builds work from their own copy of them
+	TMap<uint32, FNavGridBlock>& Blocks = LinkedNavData->GetNavigationBlocks();
 	for (const auto& [UniqueID, AreaBox, SupportedAgents, Level] : RegisteredBoundsForThisData) {
-		const auto* BlockData = LinkedNavData->LevelData->GetBlock(UniqueID);
+		const auto* BlockData = Blocks.Find(UniqueID);
 
 		if (BlockData == nullptr) {
-			LinkedNavData->LevelData->AddBlock(UniqueID, FNavGridBlock(AreaBox, UniqueID));
+			Blocks.Add(UniqueID, FNavGridBlock(AreaBox, UniqueID));
 			continue;
 		}
 
 		if (!BlockData->Bounds.Equals(AreaBox, 0.001)) {
-			LinkedNavData->LevelData->UpdateBlock(UniqueID, FNavGridBlock(AreaBox, UniqueID));
+			Blocks[UniqueID] = FNavGridBlock(AreaBox, UniqueID);
 		}
 	}
 
 	// determine whether a nav volume has been deleted
 	// first, get a list of all of the existing level blocks
 	TMap<uint32, bool> BoundIsRegistered;
-	for (const auto& [LevelBlockID, Value] : LinkedNavData->LevelData->Blocks) {
+	for (const auto& [LevelBlockID, Value] : Blocks) {
 		BoundIsRegistered.Add(LevelBlockID, false);
 	}
 
@@ -105,7 +107,7 @@ void FNavigationGridDataGenerator::RebuildDirtyAreas(const TArray<FNavigationDir
 	for (const auto& [LevelBlockID, IsBlockRegistered] : BoundIsRegistered) {
 		if (!IsBlockRegistered) {
 			UE_LOG(LogNavigationGridDataGenerator, Log, TEXT("Found unregistered navigation block '%u'; removing its level data"), LevelBlockID);
-			LinkedNavData->LevelData->RemoveBlock(LevelBlockID);
+			Blocks.Remove(LevelBlockID);
 		}
 	}
 
@@ -12,6 +12,12 @@ public:
 
 	static constexpr float ASSUMED_GRID_SPACING = 100.0;
 
+	// width and depth, in grid cells, of the clusters used by hierarchical pathfinding
+	static constexpr int64 HierarchyClusterSize = 16;
+
+	// width and depth, in grid cells, of the tiles a build is split into so that they can be traced in parallel
+	static constexpr int32 BuildTileSize = 32;
+
 	static FIntVector2 WorldToGridIndex(const FVector2f& WorldCoord)
 	{
 		return FIntVector2(
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridNavigatorTypes.generated.h"
+
+/**
+ * @brief Search algorithm used to find paths through navigation grid data.
+ */
+UENUM(BlueprintType)
+enum class EGridNavigatorSearchMode : uint8
+{
+	// plain A*; expands every reachable neighbor
+	AStar UMETA(DisplayName="A*"),
+
+	// jump point search; skips symmetric expansions across flat regions that only use Direct edges
+	JumpPoint UMETA(DisplayName="Jump Point Search"),
+
+	// hierarchical A* over fixed-size clusters; much faster for long queries, but paths may be slightly longer
+	Hierarchical UMETA(DisplayName="Hierarchical A*"),
+
+	// A* from both ends at once; gives up early when the goal sits in a small, disconnected region
+	Bidirectional UMETA(DisplayName="Bidirectional A*"),
+
+	// follows a cached flow field towards the goal; the first query to a goal searches the whole grid, but every
+	// later query to the same goal just reads the field
+	FlowField UMETA(DisplayName="Flow Field"),
+};
+
+/**
+ * @brief How the grid nodes of a path are reduced to the points handed to path followers.
+ */
+UENUM(BlueprintType)
+enum class EGridNavigatorPathSmoothing : uint8
+{
+	// keeps a point at every change of direction, so diagonal runs come out as staircases
+	RemoveCollinear UMETA(DisplayName="Remove Collinear Points"),
+
+	// also drops every point the path can cut straight past across flat, connected grid cells
+	AnyAngle UMETA(DisplayName="Any-Angle"),
+};
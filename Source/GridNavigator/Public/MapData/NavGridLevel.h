@@ -3,8 +3,19 @@
 
 #include "CoreMinimal.h"
 #include "MapData/NavGridAdjacencyList.h"
+#include "MapData/NavGridComponents.h"
+#include "MapData/NavGridFrozenGraph.h"
+#include "MapData/NavGridHierarchy.h"
+#include "MapData/NavGridLandmarks.h"
 #include "NavGridLevel.generated.h"
 
+/**
+ * @brief The navigation grid built for a set of navigation blocks, along with everything derived from it.
+ *
+ * A level is filled in by a single build, and is then published by ANavigationGridData as an immutable snapshot:
+ * the next build fills in a new level instead of editing this one. Queries hold a shared reference to the
+ * snapshot they started with, so they can run on any thread while newer snapshots are built and published.
+ */
 USTRUCT(Blueprintable, BlueprintType)
 struct FNavGridLevel
 {
@@ -90,6 +101,14 @@ struct FNavGridLevel
 		Blocks.Remove(ID);
 	}
 
+	/**
+	 * @brief Streams the nodes of the grid that lie inside a navigation block, without copying them.
+	 *
+	 * @param ID UniqueID (from FNavigationBounds) that identifies the block/nav bound
+	 * @return The nodes inside the block's bounds, or an empty range if the level has no such block
+	 */
+	FNavGridAdjacencyList::FNodeRange GetBlockNodes(uint32 ID) const;
+
 	/**
 	 * @brief Retrieves a string that summarizes the data currently stored by the level.
 	 * 
@@ -104,6 +123,42 @@ struct FNavGridLevel
 	 */
 	FBox GetBounds() const;
 
+	/**
+	 * @brief Rebuilds the hierarchical search graph from scratch for every block in the level.
+	 */
+	void RebuildHierarchy();
+
+	/**
+	 * @brief Starts from the hierarchical search graph of a previous snapshot and rebuilds only the clusters
+	 * around nodes that changed since, rather than the whole graph.
+	 *
+	 * @param PreviousHierarchy The hierarchy built from the previous snapshot's map
+	 * @param ChangedNodes The nodes whose traversable edges differ between the previous snapshot's map and Map
+	 */
+	void UpdateHierarchy(const FNavGridHierarchy& PreviousHierarchy, TConstArrayView<FInt64Vector3> ChangedNodes);
+
+	/**
+	 * @brief Compiles Map into the frozen graph that searches run on, and lays the landmark tables out in its node
+	 * order. Must be called whenever Map or Landmarks have changed.
+	 */
+	void FreezeGraph();
+
 	TMap<uint32, FNavGridBlock> Blocks;
 	FNavGridAdjacencyList Map;
+
+	// derived from Map, so it is rebuilt rather than serialized
+	FNavGridHierarchy Hierarchy;
+
+	// also derived from Map, but serialized, since computing it takes several searches over the whole grid
+	FNavGridLandmarks Landmarks;
+
+	// derived from Map and cheap to relabel, so rebuilt rather than serialized
+	FNavGridComponents Components;
+
+	// read-only copy of Map for searches; compiled from it in linear time, so rebuilt rather than serialized
+	FNavGridFrozenGraph Graph;
+
+	// graph version of the snapshot, assigned when it is published (see ANavigationGridData::GetGraphVersion);
+	// 0 for a level that has never been published
+	uint32 Version = 0;
 };
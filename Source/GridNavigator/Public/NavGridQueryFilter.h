@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridNavigatorTypes.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "NavMesh/RecastQueryFilter.h"
+#include "NavGridQueryFilter.generated.h"
+
+/**
+ * @class FNavGridQueryFilter
+ * @brief Query filter implementation that carries grid-specific query options alongside the Recast filter settings.
+ *
+ * ANavigationGridData uses it for its default query filter, so every filter made for the grid data (which starts
+ * as a copy of the default one) carries these options.
+ */
+class GRIDNAVIGATOR_API FNavGridQueryFilter : public FRecastQueryFilter
+{
+public:
+	FNavGridQueryFilter() = default;
+
+	/**
+	 * @brief Starts from the settings of a Recast filter, with the default grid options.
+	 */
+	explicit FNavGridQueryFilter(const FRecastQueryFilter& RecastFilter) : FRecastQueryFilter(RecastFilter) {}
+
+	virtual INavigationQueryFilterInterface* CreateCopy() const override;
+	virtual bool IsEqual(const INavigationQueryFilterInterface* Other) const override;
+
+	/**
+	 * @return The filter implementation as a grid filter, or nullptr if it is some other implementation (eg. a
+	 * filter made for a Recast navmesh)
+	 */
+	static const FNavGridQueryFilter* Cast(const INavigationQueryFilterInterface* Implementation);
+	static FNavGridQueryFilter* Cast(INavigationQueryFilterInterface* Implementation);
+
+	/**
+	 * @return The path smoothing requested by a query filter, or RemoveCollinear if there is no filter or it is
+	 * not a grid filter
+	 */
+	static EGridNavigatorPathSmoothing GetPathSmoothing(const FNavigationQueryFilter* Filter);
+
+	EGridNavigatorPathSmoothing PathSmoothing = EGridNavigatorPathSmoothing::RemoveCollinear;
+};
+
+/**
+ * @class UNavGridQueryFilter
+ * @brief Navigation query filter with options for queries against ANavigationGridData.
+ */
+UCLASS(Blueprintable)
+class GRIDNAVIGATOR_API UNavGridQueryFilter : public UNavigationQueryFilter
+{
+	GENERATED_BODY()
+
+public:
+	// how found paths are reduced to path points; any-angle paths have far fewer points on open ground
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Filter")
+	EGridNavigatorPathSmoothing PathSmoothing = EGridNavigatorPathSmoothing::RemoveCollinear;
+
+protected:
+	virtual void InitializeFilter(const ANavigationData& NavData, const UObject* Querier, FNavigationQueryFilter& Filter) const override;
+};
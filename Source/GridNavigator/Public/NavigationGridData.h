@@ -2,9 +2,19 @@
 
 #include "CoreMinimal.h"
 #include "NavMesh/RecastNavMesh.h"
+#include "GridNavigatorTypes.h"
 #include "MapData/NavGridLevel.h"
 #include "NavigationGridData.generated.h"
 
+class FNavGridAsyncQueryQueue;
+class FNavGridChangeJournal;
+class FNavGridCostMatrix;
+class FNavGridFlowField;
+class FNavGridFlowFieldCache;
+class FNavGridMovementRange;
+class FNavGridPathCache;
+class FNavGridTimeSlicedScheduler;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FNavigationDataBlockUpdatedDelegate, uint32, ID, const FBox&, Bounds);
 
 UCLASS()
@@ -13,7 +23,9 @@ class GRIDNAVIGATOR_API ANavigationGridData : public ARecastNavMesh
 	GENERATED_BODY()
 
 	friend class FNavigationGridDataGenerator;
+	friend class FNavGridBuildTask;
 	friend class FNavGridDataSerializer;
+	friend class FNavGridTimeSlicedScheduler;
 	
 public:
 	ANavigationGridData(const FObjectInitializer& ObjectInitializer);
@@ -23,7 +35,19 @@ public:
 	virtual UPrimitiveComponent* ConstructRenderingComponent() override;
 	virtual FBox GetBounds() const override;
 
+	// projections land on the nearest grid node with a traversable edge inside the extent; query filters do not
+	// affect them, and the projected locations carry no node reference
+	virtual bool ProjectPoint(const FVector& Point, FNavLocation& OutLocation, const FVector& Extent, FSharedConstNavQueryFilter Filter = nullptr, const UObject* Querier = nullptr) const override;
+	virtual void BatchProjectPoints(TArray<FNavigationProjectionWork>& Workload, const FVector& Extent, FSharedConstNavQueryFilter Filter = nullptr, const UObject* Querier = nullptr) const override;
+	virtual void BatchProjectPoints(TArray<FNavigationProjectionWork>& Workload, FSharedConstNavQueryFilter Filter = nullptr, const UObject* Querier = nullptr) const override;
+
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 	virtual void Serialize(FArchive& Ar) override;
+	virtual void BeginDestroy() override;
 
 	virtual void ConditionalConstructGenerator() override;
 
@@ -34,19 +58,243 @@ public:
 
 	FORCEINLINE void UpdateBlockData(const uint32 BlockID, const FBox& NewBoundData);
 
-	TMap<uint32, FNavGridBlock>& GetNavigationBlocks() const;
-	FORCEINLINE TSharedPtr<FNavGridLevel> GetLevelData() const;
+	/**
+	 * @return The navigation blocks the next build will cover; only to be used on the game thread
+	 */
+	TMap<uint32, FNavGridBlock>& GetNavigationBlocks();
 
-	FORCEINLINE TArray<NavGrid::FNode> GetNodeList() const;
+	/**
+	 * @brief Pins the most recently published snapshot of the level. Safe to call from any thread.
+	 *
+	 * Builds never modify a published snapshot, so the level can be read for as long as the pointer is held, even
+	 * while newer snapshots are being built and published.
+	 *
+	 * @return The current snapshot
+	 */
+	TSharedPtr<const FNavGridLevel> GetLevelData() const;
+	FORCEINLINE TSharedPtr<FNavGridPathCache> GetPathCache() const { return PathCache; }
+	FORCEINLINE TSharedPtr<FNavGridChangeJournal> GetChangeJournal() const { return ChangeJournal; }
 
+	/**
+	 * @return The version of the most recently published snapshot (see FNavGridLevel::Version); 0 if none has been
+	 * published yet
+	 */
+	uint32 GetGraphVersion() const;
+
+	/**
+	 * @return A copy of the current snapshot of the level, which stays valid after newer builds are published;
+	 * C++ callers should pin the snapshot with GetLevelData instead of copying it
+	 */
 	UFUNCTION(BlueprintCallable, Category="Navigation", DisplayName="Get Level Data")
-	FORCEINLINE FNavGridLevel& GetLevelDataBlueprint() const;
+	FNavGridLevel GetLevelDataBlueprint() const;
+
+	/**
+	 * @brief Queues a pathfinding query to run on a worker thread, batched with the other queries issued this frame.
+	 *
+	 * @param AgentProperties Properties of the agent the path is for
+	 * @param Query The query to run; its NavData should be this object
+	 * @param ResultDelegate Called on the game thread with the query's result once it has finished
+	 * @return ID of the query, which is also passed to ResultDelegate
+	 */
+	uint32 FindPathAsync(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query, const FNavPathQueryDelegate& ResultDelegate) const;
+
+	/**
+	 * @brief Queues a pathfinding query to be searched on the game thread over several frames.
+	 *
+	 * Pending queries share a fixed time budget each frame (see TimeSlicedBudgetMs), so long queries never spike
+	 * a single frame. Always uses A* search, regardless of SearchMode.
+	 *
+	 * @param Query The query to run; its NavData should be this object
+	 * @param ResultDelegate Called on the game thread with the query's result once it has finished
+	 * @return ID of the query, which is also passed to ResultDelegate
+	 */
+	uint32 FindPathTimeSliced(const FPathFindingQuery& Query, const FNavPathQueryDelegate& ResultDelegate) const;
+
+	/**
+	 * @brief Drops a query queued by FindPathTimeSliced; its result delegate will not be called.
+	 *
+	 * @return \c true if the query was still pending; \c false otherwise
+	 */
+	bool AbortTimeSlicedQuery(uint32 QueryID) const;
+
+	/**
+	 * @brief Finds every grid node that can be reached from a location within a movement cost, in a single search.
+	 *
+	 * @param Origin World location to measure costs from; snapped to the grid
+	 * @param CostLimit Maximum cost of a path to a node in range, in world units (the same units as FPathFindingQuery::CostLimit)
+	 * @param OutRange Receives the nodes in range, with their costs (in grid cells) and shortest paths
+	 * @return \c true if Origin lies on the grid; \c false otherwise
+	 */
+	bool FindMovementRange(const FVector& Origin, double CostLimit, FNavGridMovementRange& OutRange) const;
+
+	/**
+	 * @brief Finds every grid location that can be reached from a location within a movement cost.
+	 *
+	 * @param Origin World location to measure costs from; snapped to the grid
+	 * @param CostLimit Maximum cost of a path to a location in range, in world units
+	 * @param OutLocations Receives the world location of every grid node in range
+	 * @param OutCosts Receives the cost of reaching each entry of OutLocations, in world units
+	 * @return \c true if Origin lies on the grid; \c false otherwise
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Navigation")
+	bool GetReachableLocations(const FVector& Origin, float CostLimit, TArray<FVector>& OutLocations, TArray<float>& OutCosts) const;
+
+	/**
+	 * @brief Finds the cost of the shortest path from every source location to every target location, without
+	 * building any of the paths. Runs one search per source or per target, whichever there are fewer of, spread
+	 * across worker threads.
+	 *
+	 * @param Sources World locations paths start from; snapped to the grid
+	 * @param Targets World locations paths end at; snapped to the grid
+	 * @param OutMatrix Receives the costs, in grid cells, with one row per source and one column per target
+	 * @param CostLimit Pairs that cost more than this, in world units, are reported as unreachable
+	 * @return \c true if the matrix was built; \c false if there is no level data
+	 */
+	bool FindCostMatrix(TConstArrayView<FVector> Sources, TConstArrayView<FVector> Targets, FNavGridCostMatrix& OutMatrix, double CostLimit = TNumericLimits<double>::Max()) const;
+
+	/**
+	 * @brief Finds the cost of the shortest path from every source location to every target location.
+	 *
+	 * @param Sources World locations paths start from; snapped to the grid
+	 * @param Targets World locations paths end at; snapped to the grid
+	 * @param OutCosts Receives the costs in world units, one row of Targets.Num() entries per source; pairs with
+	 * no path between them are set to -1
+	 * @return \c true if the costs were found; \c false if there is no level data
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Navigation")
+	bool GetPathCostMatrix(const TArray<FVector>& Sources, const TArray<FVector>& Targets, TArray<float>& OutCosts) const;
+
+	/**
+	 * @brief Checks whether two locations lie in the same connected area of the grid, without searching it.
+	 *
+	 * Locations in different areas never have a path between them. Locations in the same area almost always do,
+	 * though a one-way drop can still leave the way back impossible.
+	 *
+	 * @param A World location; snapped to the grid
+	 * @param B World location; snapped to the grid
+	 * @return \c true if both locations lie on the grid in the same connected area; \c false otherwise
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation")
+	bool AreConnected(const FVector& A, const FVector& B) const;
+
+	/**
+	 * @brief Returns the flow field that leads every grid node towards a goal, building it if it is not cached.
+	 *
+	 * Agents sharing a destination can share its field, and read their next step from it in constant time.
+	 * Cached fields are rebuilt on demand once the graph has changed.
+	 *
+	 * @param Goal World location to lead towards; snapped to the grid
+	 * @return The flow field; empty if Goal does not lie on the grid
+	 */
+	TSharedRef<const FNavGridFlowField> GetFlowField(const FVector& Goal) const;
+
+	/**
+	 * @brief Builds a path for a query by following a flow field, without searching the grid again.
+	 *
+	 * @param FlowField Flow field towards the query's end location (see GetFlowField)
+	 * @param Query The query to build a path for; its path instance is filled if set, and its cost limit is honored.
+	 * Its start location is snapped to the grid
+	 * @return The query's result, with a path from the query's start location to the field's goal
+	 */
+	FPathFindingResult FindPathFromFlowField(const FNavGridFlowField& FlowField, const FPathFindingQuery& Query) const;
 
 	UPROPERTY(BlueprintAssignable, Category = "Navigation")
 	FNavigationDataBlockUpdatedDelegate OnNavigationDataBlockUpdated;
 
+	// search algorithm used by pathfinding queries against this data
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation")
+	EGridNavigatorSearchMode SearchMode = EGridNavigatorSearchMode::AStar;
+
+	// maximum number of pathfinding results kept for reuse by identical queries; 0 disables the cache; applied when loaded or edited
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Navigation", meta = (ClampMin = "0"))
+	int32 PathCacheCapacity = 256;
+
+	// game thread time, in milliseconds, shared by all time-sliced pathfinding queries each frame
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation", meta = (ClampMin = "0.0"))
+	float TimeSlicedBudgetMs = 1.0f;
+
+	// maximum number of flow fields kept for reuse by queries to the same goal; 0 disables the cache; applied when loaded or edited
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Navigation", meta = (ClampMin = "0"))
+	int32 FlowFieldCacheCapacity = 8;
+
+	// number of landmarks whose distances to every node are precomputed when the grid is built, to guide A*
+	// around walls and height changes; each one costs 8 bytes per node, and 0 disables them
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation", meta = (ClampMin = "0", ClampMax = "32"))
+	int32 NumLandmarks = 0;
+
 private:
 	static FPathFindingResult FindPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query);
 
+	/**
+	 * @brief Makes the default query filter a grid filter again, keeping its Recast settings. ARecastNavMesh
+	 * recreates its default filter as a plain Recast one whenever its settings change, so this follows each time.
+	 */
+	void UseGridQueryFilter();
+
+	/**
+	 * @brief Resizes the path and flow field caches to PathCacheCapacity and FlowFieldCacheCapacity. Queries never
+	 * resize them, so the capacities are applied once they are loaded and whenever they are edited.
+	 */
+	void ApplyCacheCapacities();
+
+	/**
+	 * @return The query's cost limit, converted from world units to the grid cells that edge costs are measured in
+	 */
+	static double GetGridCostLimit(const FPathFindingQuery& Query);
+
+	/**
+	 * @brief Points a query's result at the path instance it should fill, creating one if the query has none.
+	 *
+	 * @return \c true if the result has a path instance to fill; \c false otherwise
+	 */
+	static bool PreparePathResult(const ANavigationGridData& Self, const FPathFindingQuery& Query, FPathFindingResult& Result);
+
+	/**
+	 * @brief Fills a prepared result's path with the points found for a query, and sets its outcome.
+	 */
+	static void FinishPathResult(const FPathFindingQuery& Query, const TArray<FVector>& Points, FPathFindingResult& Result);
+
+	/**
+	 * @brief Projects every valid entry of a workload onto the grid, spread across worker threads once there are
+	 * enough of them.
+	 *
+	 * @param GetSearchBounds Returns the world space box to look for a work item's node in
+	 */
+	void ProjectWorkload(TArray<FNavigationProjectionWork>& Workload, TFunctionRef<FBox(const FNavigationProjectionWork&)> GetSearchBounds) const;
+
+	/**
+	 * @return The world location of the grid node nearest to a location within the default query extent, or the
+	 * location itself if there is no such node
+	 */
+	FVector SnapToNode(const FNavGridLevel& Level, const FVector& Location) const;
+
+	/**
+	 * @brief Returns the flow field towards a goal, snapped to the grid, over a particular snapshot of the level.
+	 */
+	TSharedRef<const FNavGridFlowField> GetFlowField(const FNavGridLevel& Level, const FVector& Goal) const;
+
+	/**
+	 * @brief Replaces the current snapshot with a newly built level, which must not be modified afterwards.
+	 * Queries that pinned the previous snapshot keep running against it.
+	 *
+	 * @param NewLevel The finished level; it is assigned the next graph version
+	 * @param ChangedNodes Every node whose edges differ between the previous snapshot and NewLevel
+	 */
+	void PublishLevelData(const TSharedRef<FNavGridLevel>& NewLevel, TArray<FInt64Vector3>&& ChangedNodes);
+
+	// navigation blocks the next build will cover; edited on the game thread, and copied by each build as it starts
+	TMap<uint32, FNavGridBlock> Blocks;
+
+	// the current snapshot; the pointer itself is swapped when a build is published, so it is only read under the lock
 	TSharedPtr<FNavGridLevel> LevelData = nullptr;
+	mutable FCriticalSection LevelDataLock;
+
+	// version given to the most recently published snapshot; advanced by PublishLevelData under LevelDataLock
+	uint32 GraphVersion = 0;
+
+	TSharedPtr<FNavGridPathCache> PathCache = nullptr;
+	TSharedPtr<FNavGridChangeJournal> ChangeJournal = nullptr;
+	TSharedPtr<FNavGridFlowFieldCache> FlowFields = nullptr;
+	TSharedPtr<FNavGridAsyncQueryQueue> AsyncQueries = nullptr;
+	TSharedPtr<FNavGridTimeSlicedScheduler> TimeSlicedQueries = nullptr;
 };